@@ -68,6 +68,41 @@ string dev::readFileAsString(string const& _file)
 	return readFile<string>(_file);
 }
 
+bool dev::writeFileAtomically(string const& _path, string const& _data)
+{
+	boost::filesystem::path temporaryPath;
+	try
+	{
+		boost::filesystem::path const path(_path);
+		if (path.has_parent_path())
+			boost::filesystem::create_directories(path.parent_path());
+
+		// Renaming is atomic, unlike writing the file in place.
+		temporaryPath = boost::filesystem::unique_path(_path + ".%%%%-%%%%-%%%%");
+		{
+			ofstream file(temporaryPath.string(), ios::binary);
+			file.write(_data.data(), streamsize(_data.size()));
+			if (!file)
+			{
+				file.close();
+				boost::filesystem::remove(temporaryPath);
+				return false;
+			}
+		}
+		boost::filesystem::rename(temporaryPath, path);
+		return true;
+	}
+	catch (boost::filesystem::filesystem_error const&)
+	{
+		if (!temporaryPath.empty())
+		{
+			boost::system::error_code ignored;
+			boost::filesystem::remove(temporaryPath, ignored);
+		}
+		return false;
+	}
+}
+
 string dev::readStandardInput()
 {
 	string ret;
@@ -35,6 +35,11 @@ namespace dev
 /// If the file doesn't exist or isn't readable, returns an empty container / bytes.
 std::string readFileAsString(std::string const& _file);
 
+/// Writes @a _data to the file @a _path, creating missing directories. The data is written to a
+/// temporary file first, which is then renamed, so that readers only ever see complete files.
+/// @returns false if the file could not be written.
+bool writeFileAtomically(std::string const& _path, std::string const& _data);
+
 /// Retrieve and returns the contents of standard input (until EOF).
 std::string readStandardInput();
 
@@ -0,0 +1,75 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Simple fixed-size pool of worker threads.
+ */
+
+#include <libdevcore/ThreadPool.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace dev;
+
+ThreadPool::ThreadPool(size_t _threads)
+{
+	for (size_t i = 0; i < max<size_t>(_threads, 1); ++i)
+		m_workers.emplace_back([this]() { work(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_condition.notify_all();
+	for (thread& worker: m_workers)
+		worker.join();
+}
+
+unsigned ThreadPool::hardwareConcurrency()
+{
+	return max(thread::hardware_concurrency(), 1u);
+}
+
+void ThreadPool::enqueue(function<void()> _task)
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_tasks.emplace_back(move(_task));
+	}
+	m_condition.notify_one();
+}
+
+void ThreadPool::work()
+{
+	while (true)
+	{
+		function<void()> task;
+		{
+			unique_lock<mutex> lock(m_mutex);
+			m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+			// Pending tasks are still processed when stopping.
+			if (m_tasks.empty())
+				return;
+			task = move(m_tasks.front());
+			m_tasks.pop_front();
+		}
+		task();
+	}
+}
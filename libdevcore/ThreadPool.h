@@ -0,0 +1,81 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Simple fixed-size pool of worker threads.
+ */
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dev
+{
+
+/**
+ * Fixed-size pool of worker threads that process tasks in FIFO order.
+ *
+ * Since tasks are started in the order they were submitted, a task may block
+ * on the result of any task submitted before it without risking a deadlock.
+ *
+ * The destructor waits for all submitted tasks to finish.
+ */
+class ThreadPool: boost::noncopyable
+{
+public:
+	/// Creates a pool with @a _threads worker threads. Zero is treated as one.
+	explicit ThreadPool(size_t _threads);
+	~ThreadPool();
+
+	/// Schedules @a _task for execution.
+	/// @returns a future that provides the result of the task or the exception it threw.
+	template <class F>
+	auto submit(F&& _task) -> std::future<decltype(_task())>
+	{
+		using ResultType = decltype(_task());
+		auto task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<F>(_task));
+		std::future<ResultType> result = task->get_future();
+		enqueue([task]() { (*task)(); });
+		return result;
+	}
+
+	/// @returns the number of worker threads.
+	size_t size() const { return m_workers.size(); }
+
+	/// @returns the number of concurrent threads supported by the hardware, but at least one.
+	static unsigned hardwareConcurrency();
+
+private:
+	void enqueue(std::function<void()> _task);
+	void work();
+
+	std::vector<std::thread> m_workers;
+	std::deque<std::function<void()>> m_tasks;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	bool m_stopping = false;
+};
+
+}
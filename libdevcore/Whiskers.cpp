@@ -25,13 +25,48 @@
 
 #include <libdevcore/Assertions.h>
 
-#include <boost/regex.hpp>
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
 
 using namespace std;
 using namespace dev;
 
+/// A part of a template: the whole template, a list body or one branch of a condition.
+struct Whiskers::Block
+{
+	/// The text of this part, used in error messages.
+	string text;
+	vector<Segment> segments;
+};
+
+struct Whiskers::Segment
+{
+	enum class Kind { Text, Tag, List, Condition };
+
+	Kind kind;
+	/// The literal text or the name of the parameter.
+	string value;
+	/// The body of a list or the true and false branches of a condition.
+	vector<Block> blocks;
+};
+
+namespace
+{
+
+bool isParameterCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
+}
+
 Whiskers::Whiskers(string _template):
-	m_template(move(_template))
+	m_template(parsed(_template))
 {
 }
 
@@ -67,14 +102,16 @@ Whiskers& Whiskers::operator()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	string output;
+	output.reserve(m_template->text.size());
+	render(*m_template, nullptr, output);
+	return output;
 }
 
 void Whiskers::checkParameterValid(string const& _parameter) const
 {
-	static boost::regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		boost::regex_match(_parameter, validParam),
+		!_parameter.empty() && all_of(_parameter.begin(), _parameter.end(), isParameterCharacter),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -99,72 +136,156 @@ void Whiskers::checkParameterUnknown(string const& _parameter) const
 	);
 }
 
-string Whiskers::replace(
-	string const& _template,
-	StringMap const& _parameters,
-	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
-)
+shared_ptr<Whiskers::Block const> Whiskers::parsed(string const& _template)
+{
+	static mutex cacheMutex;
+	static unordered_map<string, shared_ptr<Block const>> cache;
+
+	lock_guard<mutex> lock(cacheMutex);
+	shared_ptr<Block const>& block = cache[_template];
+	if (!block)
+		block = make_shared<Block const>(parse(_template));
+	return block;
+}
+
+Whiskers::Block Whiskers::parse(string _template)
 {
-	using namespace boost;
-	static regex listOrTag("<(" + paramRegex() + ")>|<#(" + paramRegex() + ")>(.*?)</\\2>|<\\?(" + paramRegex() + ")>(.*?)(<!\\4>(.*?))?</\\4>");
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
+	// Tags are matched from left to right. The body of a list or condition ends at the
+	// first matching closing tag, a condition without such a closing tag or a tag with an
+	// invalid name is kept as regular text.
+	Block block;
+	vector<Segment>& segments = block.segments;
+	size_t textStart = 0;
+	auto addText = [&](size_t _end) {
+		if (_end > textStart)
+			segments.push_back({Segment::Kind::Text, _template.substr(textStart, _end - textStart), {}});
+	};
+
+	for (size_t pos = _template.find('<'); pos != string::npos; pos = _template.find('<', pos))
 	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
+		size_t nameStart = pos + 1;
+		Segment::Kind kind = Segment::Kind::Tag;
+		if (nameStart < _template.size() && _template[nameStart] == '#')
+			kind = Segment::Kind::List;
+		else if (nameStart < _template.size() && _template[nameStart] == '?')
+			kind = Segment::Kind::Condition;
+		if (kind != Segment::Kind::Tag)
+			nameStart++;
+		size_t nameEnd = nameStart;
+		while (nameEnd < _template.size() && isParameterCharacter(_template[nameEnd]))
+			nameEnd++;
+		if (nameEnd == nameStart || nameEnd == _template.size() || _template[nameEnd] != '>')
 		{
+			pos++;
+			continue;
+		}
+		string name = _template.substr(nameStart, nameEnd - nameStart);
+		size_t bodyStart = nameEnd + 1;
+
+		if (kind == Segment::Kind::Tag)
+		{
+			addText(pos);
+			segments.push_back({kind, move(name), {}});
+			pos = textStart = bodyStart;
+			continue;
+		}
+
+		string closingTag = "</" + name + ">";
+		size_t bodyEnd = _template.find(closingTag, bodyStart);
+		if (bodyEnd == string::npos)
+		{
+			pos++;
+			continue;
+		}
+
+		vector<Block> blocks;
+		if (kind == Segment::Kind::List)
+			blocks.push_back(parse(_template.substr(bodyStart, bodyEnd - bodyStart)));
+		else
+		{
+			string elseTag = "<!" + name + ">";
+			size_t elsePos = _template.find(elseTag, bodyStart);
+			if (elsePos < bodyEnd)
+			{
+				blocks.push_back(parse(_template.substr(bodyStart, elsePos - bodyStart)));
+				size_t elseStart = elsePos + elseTag.size();
+				blocks.push_back(parse(_template.substr(elseStart, bodyEnd - elseStart)));
+			}
+			else
+			{
+				blocks.push_back(parse(_template.substr(bodyStart, bodyEnd - bodyStart)));
+				blocks.emplace_back();
+			}
+		}
+		addText(pos);
+		segments.push_back({kind, move(name), move(blocks)});
+		pos = textStart = bodyEnd + closingTag.size();
+	}
+	addText(_template.size());
+
+	block.text = move(_template);
+	return block;
+}
+
+void Whiskers::render(Block const& _block, StringMap const* _listElement, string& _output) const
+{
+	for (Segment const& segment: _block.segments)
+		switch (segment.kind)
+		{
+		case Segment::Kind::Text:
+			_output += segment.value;
+			break;
+		case Segment::Kind::Tag:
+		{
+			if (_listElement)
+			{
+				auto it = _listElement->find(segment.value);
+				if (it != _listElement->end())
+				{
+					_output += it->second;
+					break;
+				}
+			}
+			auto it = m_parameters.find(segment.value);
 			assertThrow(
-				_parameters.count(tagName),
+				it != m_parameters.end(),
 				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
+				"Value for tag " + segment.value + " not provided.\n" +
 				"Template:\n" +
-				_template
+				_block.text
 			);
-			return _parameters.at(tagName);
+			_output += it->second;
+			break;
 		}
-		else if (!listName.empty())
+		case Segment::Kind::List:
 		{
-			string templ(_match[3]);
+			// Lists cannot be nested.
+			auto it = m_listParameters.find(segment.value);
 			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
+				!_listElement && it != m_listParameters.end(),
+				WhiskersError, "List parameter " + segment.value + " not set."
 			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
+			for (StringMap const& element: it->second)
+			{
+				for (auto const& parameter: element)
+					assertThrow(
+						!m_parameters.count(parameter.first),
+						WhiskersError,
+						"Parameter collision"
+					);
+				render(segment.blocks.front(), &element, _output);
+			}
+			break;
 		}
-		else
+		case Segment::Kind::Condition:
 		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
+			auto it = m_conditions.find(segment.value);
 			assertThrow(
-				_conditions.count(conditionName),
-				WhiskersError, "Condition parameter " + conditionName + " not set."
-			);
-			return replace(
-				_conditions.at(conditionName) ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
+				it != m_conditions.end(),
+				WhiskersError, "Condition parameter " + segment.value + " not set."
 			);
+			render(segment.blocks[it->second ? 0 : 1], _listElement, _output);
+			break;
+		}
 		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
 }
-
@@ -27,6 +27,7 @@
 
 #include <string>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace dev
@@ -62,6 +63,9 @@ DEV_SIMPLE_EXCEPTION(WhiskersError);
  *  - List parameter: <#list>...</list>
  *    The part between the tags is repeated as often as values are provided
  *    in the mapping. Each list element can have its own parameter -> value mapping.
+ *
+ * Templates are parsed only once per process and the parsed form is shared between all
+ * objects created from the same template text.
  */
 class Whiskers
 {
@@ -85,24 +89,23 @@ public:
 	std::string render() const;
 
 private:
+	struct Block;
+	struct Segment;
+
 	// Prevent implicit cast to bool
 	Whiskers& operator()(std::string _parameter, long long);
 	void checkParameterValid(std::string const& _parameter) const;
 	void checkParameterUnknown(std::string const& _parameter) const;
 
-	static std::string replace(
-		std::string const& _template,
-		StringMap const& _parameters,
-		std::map<std::string, bool> const& _conditions,
-		StringListMap const& _listParameters = StringListMap()
-	);
-
-	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
+	/// @returns the parsed form of @a _template, parsing it only if it was not seen before.
+	static std::shared_ptr<Block const> parsed(std::string const& _template);
+	static Block parse(std::string _template);
 
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
+	/// Appends the expansion of @a _block to @a _output. Inside list bodies, @a _listElement
+	/// contains the parameters of the current list element and list parameters are unavailable.
+	void render(Block const& _block, StringMap const* _listElement, std::string& _output) const;
 
-	std::string m_template;
+	std::shared_ptr<Block const> m_template;
 	StringMap m_parameters;
 	std::map<std::string, bool> m_conditions;
 	StringListMap m_listParameters;
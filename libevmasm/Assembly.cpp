@@ -29,6 +29,10 @@
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/GasMeter.h>
 
+#include <libdevcore/ThreadPool.h>
+
+#include <boost/optional.hpp>
+
 #include <fstream>
 #include <json/json.h>
 
@@ -37,6 +41,69 @@ using namespace dev;
 using namespace dev::eth;
 using namespace langutil;
 
+namespace
+{
+
+/// Runs the common subexpression eliminator on the basic block [_begin, _end), whose last item
+/// may be the item that breaks the block.
+/// @returns the optimised items if they are shorter than the original ones.
+boost::optional<AssemblyItems> optimiseBlock(
+	AssemblyItems::const_iterator _begin,
+	AssemblyItems::const_iterator _end,
+	bool _usesMSize
+)
+{
+	KnownState emptyState;
+	CommonSubexpressionEliminator eliminator{emptyState};
+	auto iter = eliminator.feedItems(_begin, _end, _usesMSize);
+	assertThrow(iter == _end, OptimizerException, "Invalid basic block.");
+	try
+	{
+		AssemblyItems optimisedBlock = eliminator.getOptimizedItems();
+		if (optimisedBlock.size() < size_t(_end - _begin))
+			return optimisedBlock;
+	}
+	catch (StackTooDeepException const&)
+	{
+		// This might happen if the opcode reconstruction is not as efficient
+		// as the hand-crafted code.
+	}
+	catch (ItemNotAvailableException const&)
+	{
+		// This might happen if e.g. associativity and commutativity rules
+		// reorganise the expression tree, but not all leaves are available.
+	}
+	return {};
+}
+
+/// Runs @a _task for all indices below @a _count, split into contiguous batches on @a _threadPool
+/// if it is given. Waits for all tasks and re-throws the first exception.
+void forEachIndex(size_t _count, ThreadPool* _threadPool, function<void(size_t)> const& _task)
+{
+	if (!_threadPool || _count < 2)
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_task(i);
+		return;
+	}
+
+	// A few batches per thread balance the load without paying the scheduling cost per index.
+	size_t batches = min(_count, _threadPool->size() * 4);
+	vector<future<void>> results;
+	for (size_t batch = 0; batch < batches; ++batch)
+		results.emplace_back(_threadPool->submit([&, batch]() {
+			for (size_t i = _count * batch / batches; i < _count * (batch + 1) / batches; ++i)
+				_task(i);
+		}));
+	// All tasks have to finish before an exception is re-thrown, since they access local variables.
+	for (auto& result: results)
+		result.wait();
+	for (auto& result: results)
+		result.get();
+}
+
+}
+
 void Assembly::append(Assembly const& _a)
 {
 	auto newDeposit = m_deposit + _a.deposit();
@@ -384,28 +451,39 @@ Assembly& Assembly::optimise(bool _enable, EVMVersion _evmVersion, bool _isCreat
 
 Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 {
-	optimiseInternal(_settings, {});
+	unique_ptr<ThreadPool> threadPool;
+	if (_settings.parallelism > 1)
+		threadPool = make_unique<ThreadPool>(_settings.parallelism);
+	optimiseInternal(_settings, {}, threadPool.get());
 	return *this;
 }
 
 map<u256, u256> Assembly::optimiseInternal(
 	OptimiserSettings const& _settings,
-	std::set<size_t> _tagsReferencedFromOutside
+	std::set<size_t> _tagsReferencedFromOutside,
+	ThreadPool* _threadPool
 )
 {
 	// Run optimisation for sub-assemblies.
+	OptimiserSettings subSettings = _settings;
+	// Disable creation mode for sub-assemblies.
+	subSettings.isCreation = false;
+	// The tags referenced from here only change for a sub-assembly when its own replacements are applied.
+	vector<set<size_t>> subReferencedTags;
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
-	{
-		OptimiserSettings settings = _settings;
-		// Disable creation mode for sub-assemblies.
-		settings.isCreation = false;
-		map<u256, u256> subTagReplacements = m_subs[subId]->optimiseInternal(
-			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
-		);
-		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
-	}
+		subReferencedTags.emplace_back(JumpdestRemover::referencedTags(m_items, subId));
+	vector<map<u256, u256>> subTagReplacements(m_subs.size());
+	if (_threadPool && m_subs.size() > 1 && subAssembliesAreDisjoint())
+		// Nested sub-assemblies are optimised by the task of their parent.
+		forEachIndex(m_subs.size(), _threadPool, [&](size_t _subId) {
+			subTagReplacements[_subId] = m_subs[_subId]->optimiseInternal(subSettings, subReferencedTags[_subId], nullptr);
+		});
+	else
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+			subTagReplacements[subId] = m_subs[subId]->optimiseInternal(subSettings, subReferencedTags[subId], _threadPool);
+	// Apply the replacements (can be empty).
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements[subId], subId);
 
 	map<u256, u256> tagReplacements;
 	// Iterate until no new optimisation possibilities are found.
@@ -461,43 +539,38 @@ map<u256, u256> Assembly::optimiseInternal(
 			// Control flow graph optimization has been here before but is disabled because it
 			// assumes we only jump to tags that are pushed. This is not the case anymore with
 			// function types that can be stored in storage.
-			AssemblyItems optimisedItems;
-
 			bool usesMSize = (find(m_items.begin(), m_items.end(), AssemblyItem{Instruction::MSIZE}) != m_items.end());
 
-			auto iter = m_items.begin();
-			while (iter != m_items.end())
-			{
-				KnownState emptyState;
-				CommonSubexpressionEliminator eliminator{emptyState};
-				auto orig = iter;
-				iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
-				bool shouldReplace = false;
-				AssemblyItems optimisedChunk;
-				try
-				{
-					optimisedChunk = eliminator.getOptimizedItems();
-					shouldReplace = (optimisedChunk.size() < size_t(iter - orig));
-				}
-				catch (StackTooDeepException const&)
-				{
-					// This might happen if the opcode reconstruction is not as efficient
-					// as the hand-crafted code.
-				}
-				catch (ItemNotAvailableException const&)
+			// Every basic block is optimised on its own, so they can be processed concurrently.
+			vector<pair<size_t, size_t>> blocks;
+			for (size_t begin = 0, i = 0; i < m_items.size(); ++i)
+				if (SemanticInformation::breaksCSEAnalysisBlock(m_items[i], usesMSize) || i + 1 == m_items.size())
 				{
-					// This might happen if e.g. associativity and commutativity rules
-					// reorganise the expression tree, but not all leaves are available.
+					blocks.emplace_back(begin, i + 1);
+					begin = i + 1;
 				}
+			vector<boost::optional<AssemblyItems>> optimisedBlocks(blocks.size());
+			forEachIndex(blocks.size(), _threadPool, [&](size_t _block) {
+				optimisedBlocks[_block] = optimiseBlock(
+					m_items.cbegin() + ptrdiff_t(blocks[_block].first),
+					m_items.cbegin() + ptrdiff_t(blocks[_block].second),
+					usesMSize
+				);
+			});
 
-				if (shouldReplace)
+			AssemblyItems optimisedItems;
+			for (size_t block = 0; block < blocks.size(); ++block)
+				if (optimisedBlocks[block])
 				{
 					count++;
-					optimisedItems += optimisedChunk;
+					optimisedItems += std::move(*optimisedBlocks[block]);
 				}
 				else
-					copy(orig, iter, back_inserter(optimisedItems));
-			}
+					copy(
+						m_items.begin() + ptrdiff_t(blocks[block].first),
+						m_items.begin() + ptrdiff_t(blocks[block].second),
+						back_inserter(optimisedItems)
+					);
 			if (optimisedItems.size() < m_items.size())
 			{
 				m_items = move(optimisedItems);
@@ -517,6 +590,19 @@ map<u256, u256> Assembly::optimiseInternal(
 	return tagReplacements;
 }
 
+bool Assembly::subAssembliesAreDisjoint() const
+{
+	set<Assembly const*> seen;
+	function<bool(Assembly const&)> collect = [&](Assembly const& _assembly)
+	{
+		for (auto const& sub: _assembly.m_subs)
+			if (!seen.insert(sub.get()).second || !collect(*sub))
+				return false;
+		return true;
+	};
+	return collect(*this);
+}
+
 LinkerObject const& Assembly::assemble() const
 {
 	if (!m_assembledObject.bytecode.empty())
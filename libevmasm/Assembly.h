@@ -37,6 +37,8 @@
 
 namespace dev
 {
+class ThreadPool;
+
 namespace eth
 {
 
@@ -111,6 +113,9 @@ public:
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = 200;
+		/// Number of threads used to optimise sub-assemblies and basic blocks concurrently.
+		/// Does not influence the result.
+		unsigned parallelism = 1;
 	};
 
 	/// Modify and return the current assembly such that creation and execution gas usage
@@ -155,7 +160,17 @@ protected:
 	/// Does the same operations as @a optimise, but should only be applied to a sub and
 	/// returns the replaced tags. Also takes an argument containing the tags of this assembly
 	/// that are referenced in a super-assembly.
-	std::map<u256, u256> optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
+	/// If @a _threadPool is given, independent sub-assemblies and basic blocks are optimised
+	/// concurrently on it.
+	std::map<u256, u256> optimiseInternal(
+		OptimiserSettings const& _settings,
+		std::set<size_t> _tagsReferencedFromOutside,
+		ThreadPool* _threadPool
+	);
+
+	/// @returns true if no assembly occurs more than once among the (transitive) sub-assemblies,
+	/// so that they can be optimised concurrently.
+	bool subAssembliesAreDisjoint() const;
 
 	unsigned bytesRequired(unsigned subTagSize) const;
 
@@ -53,6 +53,9 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <algorithm>
+#include <cstring>
+
 using namespace std;
 using namespace langutil;
 
@@ -87,29 +90,48 @@ string CharStream::lineAtPosition(int _position) const
 	size_type searchStart = min<size_type>(m_source.size(), _position);
 	if (searchStart > 0)
 		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
-	if (lineStart == string::npos)
-		lineStart = 0;
-	else
-		lineStart++;
-	return m_source.substr(
-		lineStart,
-		min(m_source.find('\n', lineStart), m_source.size()) - lineStart
-	);
+	vector<size_t> const& starts = lineStarts();
+	// If searchStart is itself a newline, this is the line that follows it.
+	size_t line = lineIndex(searchStart + 1);
+	size_type lineStart = starts[line];
+	size_type lineEnd = line + 1 < starts.size() ? starts[line + 1] - 1 : m_source.size();
+	return m_source.substr(lineStart, lineEnd - lineStart);
 }
 
 tuple<int, int> CharStream::translatePositionToLineColumn(int _position) const
 {
 	using size_type = string::size_type;
 	size_type searchPosition = min<size_type>(m_source.size(), _position);
-	int lineNumber = count(m_source.begin(), m_source.begin() + searchPosition, '\n');
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
-	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
-	}
-	return tuple<int, int>(lineNumber, searchPosition - lineStart);
+	size_t line = lineIndex(searchPosition);
+	return tuple<int, int>(line, searchPosition - lineStarts()[line]);
+}
+
+vector<size_t> const& CharStream::lineStarts() const
+{
+	if (auto starts = atomic_load(&m_lineStarts))
+		return *starts;
+
+	// memchr is vectorised by the C library, so this is much faster than a loop over the characters.
+	auto starts = make_shared<vector<size_t>>(1, 0);
+	char const* begin = m_source.data();
+	char const* end = begin + m_source.size();
+	for (
+		char const* newline = static_cast<char const*>(memchr(begin, '\n', end - begin));
+		newline;
+		newline = static_cast<char const*>(memchr(newline + 1, '\n', end - newline - 1))
+	)
+		starts->push_back(newline - begin + 1);
+
+	// Concurrent calls compute the same index, so it does not matter which one is kept.
+	shared_ptr<vector<size_t> const> expected;
+	shared_ptr<vector<size_t> const> desired = move(starts);
+	if (!atomic_compare_exchange_strong(&m_lineStarts, &expected, desired))
+		return *expected;
+	return *desired;
+}
+
+size_t CharStream::lineIndex(size_t _position) const
+{
+	vector<size_t> const& starts = lineStarts();
+	return size_t(upper_bound(starts.begin(), starts.end(), _position) - starts.begin()) - 1;
 }
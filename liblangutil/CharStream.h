@@ -53,8 +53,10 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <tuple>
+#include <vector>
 
 namespace langutil
 {
@@ -92,15 +94,23 @@ public:
 	///@{
 	///@name Error printing helper functions
 	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
+	/// The first call builds an index of the line starts, which is then searched
+	/// by all further calls.
 	std::string lineAtPosition(int _position) const;
 	std::tuple<int, int> translatePositionToLineColumn(int _position) const;
 	///@}
 
 private:
+	/// @returns the offsets of the first characters of all lines, builds them on first use.
+	std::vector<size_t> const& lineStarts() const;
+	/// @returns the index of the line that contains the character at @a _position.
+	size_t lineIndex(size_t _position) const;
+
 	std::string m_source;
 	std::string m_name;
 	size_t m_position{0};
+	/// Cache for @a lineStarts, shared between copies of the stream.
+	mutable std::shared_ptr<std::vector<size_t> const> m_lineStarts;
 };
 
 }
@@ -35,7 +35,7 @@ namespace dev
 namespace solidity
 {
 
-inline vector<shared_ptr<MagicVariableDeclaration const>> constructMagicVariables()
+inline vector<shared_ptr<MagicVariableDeclaration>> constructMagicVariables()
 {
 	static auto const magicVarDecl = [](string const& _name, Type const* _type) {
 		return make_shared<MagicVariableDeclaration>(_name, _type);
@@ -91,11 +91,24 @@ vector<Declaration const*> GlobalContext::declarations() const
 {
 	vector<Declaration const*> declarations;
 	declarations.reserve(m_magicVariables.size());
-	for (ASTPointer<Declaration const> const& variable: m_magicVariables)
+	for (auto const& variable: m_magicVariables)
 		declarations.push_back(variable.get());
 	return declarations;
 }
 
+size_t GlobalContext::renumberDeclarations(size_t _lastID, vector<ContractDefinition const*> const& _contracts)
+{
+	for (auto const& variable: m_magicVariables)
+		variable->setID(++_lastID);
+	for (ContractDefinition const* contract: _contracts)
+	{
+		// Both are created when the contract is registered.
+		m_thisPointer.at(contract)->setID(++_lastID);
+		m_superPointer.at(contract)->setID(++_lastID);
+	}
+	return _lastID;
+}
+
 MagicVariableDeclaration const* GlobalContext::currentThis() const
 {
 	if (!m_thisPointer[m_currentContract])
@@ -53,11 +53,17 @@ public:
 	/// @returns a vector of all implicit global declarations excluding "this".
 	std::vector<Declaration const*> declarations() const;
 
+	/// Assigns consecutive IDs following @a _lastID to the global declarations and then to
+	/// "this" and "super" of each of @a _contracts. This is the order in which they are created
+	/// when the global context is used for the first time.
+	/// @returns the last assigned ID.
+	size_t renumberDeclarations(size_t _lastID, std::vector<ContractDefinition const*> const& _contracts);
+
 private:
-	std::vector<std::shared_ptr<MagicVariableDeclaration const>> m_magicVariables;
+	std::vector<std::shared_ptr<MagicVariableDeclaration>> m_magicVariables;
 	ContractDefinition const* m_currentContract = nullptr;
-	std::map<ContractDefinition const*, std::shared_ptr<MagicVariableDeclaration const>> mutable m_thisPointer;
-	std::map<ContractDefinition const*, std::shared_ptr<MagicVariableDeclaration const>> mutable m_superPointer;
+	std::map<ContractDefinition const*, std::shared_ptr<MagicVariableDeclaration>> mutable m_thisPointer;
+	std::map<ContractDefinition const*, std::shared_ptr<MagicVariableDeclaration>> mutable m_superPointer;
 };
 
 }
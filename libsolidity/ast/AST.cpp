@@ -39,11 +39,13 @@ class IDDispenser
 {
 public:
 	static size_t next() { return ++instance(); }
-	static void reset() { instance() = 0; }
+	static size_t last() { return instance(); }
+	static void reset(size_t _lastID) { instance() = _lastID; }
 private:
 	static size_t& instance()
 	{
-		static IDDispenser dispenser;
+		// IDs are assigned per thread so that concurrent compilations stay deterministic.
+		static thread_local IDDispenser dispenser;
 		return dispenser.id;
 	}
 	size_t id = 0;
@@ -60,9 +62,14 @@ ASTNode::~ASTNode()
 	delete m_annotation;
 }
 
-void ASTNode::resetID()
+void ASTNode::resetID(size_t _lastID)
 {
-	IDDispenser::reset();
+	IDDispenser::reset(_lastID);
+}
+
+size_t ASTNode::lastID()
+{
+	return IDDispenser::last();
 }
 
 ASTAnnotation& ASTNode::annotation() const
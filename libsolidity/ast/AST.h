@@ -70,8 +70,14 @@ public:
 
 	/// @returns an identifier of this AST node that is unique for a single compilation run.
 	size_t id() const { return m_id; }
-	/// Resets the global ID counter. This invalidates all previous IDs.
-	static void resetID();
+	/// Changes the ID of this node. Only used to move the nodes of an AST that is re-used
+	/// by a later compilation run to the IDs they would receive if they were created again.
+	void setID(size_t _id) { m_id = _id; }
+	/// Resets the global ID counter, such that the next node receives the ID @a _lastID + 1.
+	/// Resetting it to zero invalidates all previous IDs.
+	static void resetID(size_t _lastID = 0);
+	/// @returns the ID of the most recently created node.
+	static size_t lastID();
 
 	virtual void accept(ASTVisitor& _visitor) = 0;
 	virtual void accept(ASTConstVisitor& _visitor) const = 0;
@@ -108,7 +114,7 @@ public:
 	///@}
 
 protected:
-	size_t const m_id = 0;
+	size_t m_id = 0;
 	/// Annotation - is specialised in derived classes, is created upon request (because of polymorphism).
 	mutable ASTAnnotation* m_annotation = nullptr;
 
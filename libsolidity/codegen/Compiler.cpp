@@ -34,6 +34,16 @@ void Compiler::compileContract(
 	std::map<ContractDefinition const*, shared_ptr<Compiler const>> const& _otherCompilers,
 	bytes const& _metadata
 )
+{
+	generateCode(_contract, _otherCompilers, _metadata);
+	optimise();
+}
+
+void Compiler::generateCode(
+	ContractDefinition const& _contract,
+	std::map<ContractDefinition const*, shared_ptr<Compiler const>> const& _otherCompilers,
+	bytes const& _metadata
+)
 {
 	ContractCompiler runtimeCompiler(nullptr, m_runtimeContext, m_optimiserSettings);
 	runtimeCompiler.compileContract(_contract, _otherCompilers);
@@ -47,8 +57,11 @@ void Compiler::compileContract(
 	creationSettings.expectedExecutionsPerDeployment = 1;
 	ContractCompiler creationCompiler(&runtimeCompiler, m_context, creationSettings);
 	m_runtimeSub = creationCompiler.compileConstructor(_contract, _otherCompilers);
+}
 
-	m_context.optimise(m_optimiserSettings);
+void Compiler::optimise(unsigned _parallelism)
+{
+	m_context.optimise(m_optimiserSettings, _parallelism);
 }
 
 std::shared_ptr<eth::Assembly> Compiler::runtimeAssemblyPtr() const
@@ -35,10 +35,15 @@ namespace solidity {
 class Compiler
 {
 public:
-	explicit Compiler(langutil::EVMVersion _evmVersion, OptimiserSettings _optimiserSettings):
+	/// @a _yulFunctionCache, if given, is shared with the compilers of the other contracts.
+	explicit Compiler(
+		langutil::EVMVersion _evmVersion,
+		OptimiserSettings _optimiserSettings,
+		std::shared_ptr<YulFunctionCache> _yulFunctionCache = nullptr
+	):
 		m_optimiserSettings(std::move(_optimiserSettings)),
-		m_runtimeContext(_evmVersion),
-		m_context(_evmVersion, &m_runtimeContext)
+		m_runtimeContext(_evmVersion, nullptr, _yulFunctionCache),
+		m_context(_evmVersion, &m_runtimeContext, _yulFunctionCache)
 	{ }
 
 	/// Compiles a contract.
@@ -48,6 +53,16 @@ public:
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers,
 		bytes const& _metadata
 	);
+	/// Generates the unoptimised assembly of a contract. Has to be followed by a call to @a optimise.
+	/// @arg _metadata contains the to be injected metadata CBOR
+	void generateCode(
+		ContractDefinition const& _contract,
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers,
+		bytes const& _metadata
+	);
+	/// Runs the assembly optimiser on the generated assembly using @a _parallelism threads.
+	/// This only accesses the assembly of the contract and the assemblies of the contracts it creates.
+	void optimise(unsigned _parallelism = 1);
 	/// @returns Entire assembly.
 	eth::Assembly const& assembly() const { return m_context.assembly(); }
 	/// @returns Entire assembly as a shared pointer to non-const.
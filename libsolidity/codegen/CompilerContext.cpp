@@ -25,6 +25,7 @@
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/codegen/CompilerUtils.h>
+#include <libsolidity/codegen/InlineAssemblyCache.h>
 #include <libsolidity/interface/Version.h>
 
 #include <libyul/AsmParser.h>
@@ -43,6 +44,7 @@
 
 #include <boost/algorithm/string/replace.hpp>
 
+#include <chrono>
 #include <utility>
 #include <numeric>
 
@@ -336,12 +338,6 @@ void CompilerContext::appendInlineAssembly(
 {
 	int startStackHeight = stackHeight();
 
-	set<yul::YulString> externallyUsedIdentifiers;
-	for (auto const& fun: _externallyUsedFunctions)
-		externallyUsedIdentifiers.insert(yul::YulString(fun));
-	for (auto const& var: _localVariables)
-		externallyUsedIdentifiers.insert(yul::YulString(var));
-
 	yul::ExternalIdentifierAccess identifierAccess;
 	identifierAccess.resolve = [&](
 		yul::Identifier const& _identifier,
@@ -381,74 +377,111 @@ void CompilerContext::appendInlineAssembly(
 		}
 	};
 
-	ErrorList errors;
-	ErrorReporter errorReporter(errors);
-	auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_assembly, "--CODEGEN--"));
-	yul::EVMDialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_evmVersion);
-	auto parserResult = yul::Parser(errorReporter, dialect).parse(scanner, false);
-#ifdef SOL_OUTPUT_ASM
-	cout << yul::AsmPrinter()(*parserResult) << endl;
-#endif
-
-	auto reportError = [&](string const& _context)
-	{
-		string message =
-			"Error parsing/analyzing inline assembly block:\n" +
-			_context + "\n"
-			"------------------ Input: -----------------\n" +
-			_assembly + "\n"
-			"------------------ Errors: ----------------\n";
-		for (auto const& error: errorReporter.errors())
-			message += SourceReferenceFormatter::formatErrorInformation(*error);
-		message += "-------------------------------------------\n";
-
-		solAssert(false, message);
-	};
-
-	yul::AsmAnalysisInfo analysisInfo;
-	bool analyzerResult = false;
-	if (parserResult)
-		analyzerResult = yul::AsmAnalyzer(
-			analysisInfo,
-			errorReporter,
-			boost::none,
-			dialect,
-			identifierAccess.resolve
-		).analyze(*parserResult);
-	if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
-		reportError("Invalid assembly generated by code generator.");
-
+	// The parsed and optimised snippets are shared between contracts and compilations,
+	// so the key has to contain everything the resulting block depends on.
 	// Several optimizer steps cannot handle externally supplied stack variables,
 	// so we essentially only optimize the ABI functions.
-	if (_optimiserSettings.runYulOptimiser && _localVariables.empty())
+	bool const optimize = _optimiserSettings.runYulOptimiser && _localVariables.empty();
+	bool const isCreation = m_runtimeContext != nullptr;
+	string cacheKey = m_evmVersion.name() + '\0';
+	for (auto const& var: _localVariables)
+		cacheKey += var + ',';
+	cacheKey += '\0';
+	if (optimize)
+	{
+		cacheKey +=
+			string(isCreation ? "creation" : "runtime") + '\0' +
+			to_string(_optimiserSettings.expectedExecutionsPerDeployment) + '\0' +
+			(_optimiserSettings.optimizeStackAllocation ? "1" : "0") + '\0';
+		for (auto const& fun: _externallyUsedFunctions)
+			cacheKey += fun + ',';
+	}
+	cacheKey += '\0' + _assembly;
+
+	shared_ptr<InlineAssemblyCache::Snippet const> snippet = InlineAssemblyCache::instance().lookup(cacheKey);
+	if (!snippet)
 	{
-		bool const isCreation = m_runtimeContext != nullptr;
-		yul::GasMeter meter(dialect, isCreation, _optimiserSettings.expectedExecutionsPerDeployment);
-		yul::Object obj;
-		obj.code = parserResult;
-		obj.analysisInfo = make_shared<yul::AsmAnalysisInfo>(analysisInfo);
-		yul::OptimiserSuite::run(
-			dialect,
-			&meter,
-			obj,
-			_optimiserSettings.optimizeStackAllocation,
-			externallyUsedIdentifiers
-		);
-		analysisInfo = std::move(*obj.analysisInfo);
-		parserResult = std::move(obj.code);
+		auto startTime = chrono::steady_clock::now();
 
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_assembly, "--CODEGEN--"));
+		yul::EVMDialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_evmVersion);
+		auto parserResult = yul::Parser(errorReporter, dialect).parse(scanner, false);
 #ifdef SOL_OUTPUT_ASM
-		cout << "After optimizer: " << endl;
 		cout << yul::AsmPrinter()(*parserResult) << endl;
 #endif
-	}
 
-	if (!errorReporter.errors().empty())
-		reportError("Failed to analyze inline assembly block.");
+		auto reportError = [&](string const& _context)
+		{
+			string message =
+				"Error parsing/analyzing inline assembly block:\n" +
+				_context + "\n"
+				"------------------ Input: -----------------\n" +
+				_assembly + "\n"
+				"------------------ Errors: ----------------\n";
+			for (auto const& error: errorReporter.errors())
+				message += SourceReferenceFormatter::formatErrorInformation(*error);
+			message += "-------------------------------------------\n";
+
+			solAssert(false, message);
+		};
+
+		yul::AsmAnalysisInfo analysisInfo;
+		bool analyzerResult = false;
+		if (parserResult)
+			analyzerResult = yul::AsmAnalyzer(
+				analysisInfo,
+				errorReporter,
+				boost::none,
+				dialect,
+				identifierAccess.resolve
+			).analyze(*parserResult);
+		if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
+			reportError("Invalid assembly generated by code generator.");
+
+		if (optimize)
+		{
+			set<yul::YulString> externallyUsedIdentifiers;
+			for (auto const& fun: _externallyUsedFunctions)
+				externallyUsedIdentifiers.insert(yul::YulString(fun));
+
+			yul::GasMeter meter(dialect, isCreation, _optimiserSettings.expectedExecutionsPerDeployment);
+			yul::Object obj;
+			obj.code = parserResult;
+			obj.analysisInfo = make_shared<yul::AsmAnalysisInfo>(analysisInfo);
+			yul::OptimiserSuite::run(
+				dialect,
+				&meter,
+				obj,
+				_optimiserSettings.optimizeStackAllocation,
+				externallyUsedIdentifiers
+			);
+			analysisInfo = std::move(*obj.analysisInfo);
+			parserResult = std::move(obj.code);
+
+#ifdef SOL_OUTPUT_ASM
+			cout << "After optimizer: " << endl;
+			cout << yul::AsmPrinter()(*parserResult) << endl;
+#endif
+		}
+
+		if (!errorReporter.errors().empty())
+			reportError("Failed to analyze inline assembly block.");
+
+		solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
+		snippet = make_shared<InlineAssemblyCache::Snippet const>(InlineAssemblyCache::Snippet{
+			std::move(parserResult),
+			std::move(analysisInfo),
+			chrono::steady_clock::now() - startTime
+		});
+		InlineAssemblyCache::instance().store(std::move(cacheKey), snippet);
+	}
 
-	solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
+	// The code transform does not modify the analysis info, but it requires a mutable reference.
+	yul::AsmAnalysisInfo analysisInfo = snippet->analysisInfo;
 	yul::CodeGenerator::assemble(
-		*parserResult,
+		*snippet->code,
 		analysisInfo,
 		*m_asm,
 		m_evmVersion,
@@ -497,7 +530,7 @@ void CompilerContext::updateSourceLocation()
 eth::Assembly::OptimiserSettings CompilerContext::translateOptimiserSettings(OptimiserSettings const& _settings)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	eth::Assembly::OptimiserSettings asmSettings{false, false, false, false, false, false, m_evmVersion, 0};
+	eth::Assembly::OptimiserSettings asmSettings{false, false, false, false, false, false, m_evmVersion, 0, 1};
 	asmSettings.isCreation = true;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
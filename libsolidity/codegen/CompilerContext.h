@@ -26,6 +26,7 @@
 #include <libsolidity/ast/ASTForward.h>
 #include <libsolidity/ast/Types.h>
 #include <libsolidity/codegen/ABIFunctions.h>
+#include <libsolidity/codegen/YulFunctionCache.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
@@ -52,12 +53,19 @@ class Compiler;
 class CompilerContext
 {
 public:
-	explicit CompilerContext(langutil::EVMVersion _evmVersion, CompilerContext* _runtimeContext = nullptr):
+	/// If @a _yulFunctionCache is given, the generated ABI functions are shared with the
+	/// other contexts that use the same cache.
+	explicit CompilerContext(
+		langutil::EVMVersion _evmVersion,
+		CompilerContext* _runtimeContext = nullptr,
+		std::shared_ptr<YulFunctionCache> _yulFunctionCache = nullptr
+	):
 		m_asm(std::make_shared<eth::Assembly>()),
 		m_evmVersion(_evmVersion),
 		m_runtimeContext(_runtimeContext),
-		m_abiFunctions(m_evmVersion)
+		m_abiFunctions(m_evmVersion, std::make_shared<MultiUseYulFunctionCollector>(_yulFunctionCache))
 	{
+		solAssert(!_yulFunctionCache || _yulFunctionCache->evmVersion() == m_evmVersion, "");
 		if (m_runtimeContext)
 			m_runtimeSub = size_t(m_asm->newSub(m_runtimeContext->m_asm).data());
 	}
@@ -223,8 +231,13 @@ public:
 	/// Appends arbitrary data to the end of the bytecode.
 	void appendAuxiliaryData(bytes const& _data) { m_asm->appendAuxiliaryDataToEnd(_data); }
 
-	/// Run optimisation step.
-	void optimise(OptimiserSettings const& _settings) { m_asm->optimise(translateOptimiserSettings(_settings)); }
+	/// Run optimisation step using @a _parallelism threads.
+	void optimise(OptimiserSettings const& _settings, unsigned _parallelism = 1)
+	{
+		eth::Assembly::OptimiserSettings settings = translateOptimiserSettings(_settings);
+		settings.parallelism = _parallelism;
+		m_asm->optimise(settings);
+	}
 
 	/// @returns the runtime context if in creation mode and runtime context is set, nullptr otherwise.
 	CompilerContext* runtimeContext() const { return m_runtimeContext; }
@@ -0,0 +1,84 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Cache of the parsed, analysed and optimised inline assembly snippets of the code generator.
+ */
+
+#include <libsolidity/codegen/InlineAssemblyCache.h>
+
+#include <libyul/YulString.h>
+
+#include <boost/format.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+string InlineAssemblyCache::Statistics::toString() const
+{
+	return (
+		boost::format("Hits: %d, misses: %d, time spent: %.3f ms, time saved: %.3f ms") %
+		hits %
+		misses %
+		chrono::duration<double, milli>(timeSpent).count() %
+		chrono::duration<double, milli>(timeSaved).count()
+	).str();
+}
+
+InlineAssemblyCache& InlineAssemblyCache::instance()
+{
+	static InlineAssemblyCache cache;
+	return cache;
+}
+
+InlineAssemblyCache::InlineAssemblyCache()
+{
+	// The reset callbacks are run before the strings are removed from the repository.
+	static yul::YulStringRepository::ResetCallback callback{[this] {
+		lock_guard<mutex> lock(m_mutex);
+		m_snippets.clear();
+	}};
+}
+
+shared_ptr<InlineAssemblyCache::Snippet const> InlineAssemblyCache::lookup(string const& _key)
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_snippets.find(_key);
+	if (it == m_snippets.end())
+	{
+		m_statistics.misses++;
+		return nullptr;
+	}
+	m_statistics.hits++;
+	m_statistics.timeSaved += it->second->time;
+	return it->second;
+}
+
+void InlineAssemblyCache::store(string _key, shared_ptr<Snippet const> _snippet)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_statistics.timeSpent += _snippet->time;
+	if (m_snippets.size() >= c_maxSnippets)
+		m_snippets.clear();
+	m_snippets.emplace(move(_key), move(_snippet));
+}
+
+InlineAssemblyCache::Statistics InlineAssemblyCache::statistics() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_statistics;
+}
@@ -0,0 +1,99 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Cache of the parsed, analysed and optimised inline assembly snippets of the code generator.
+ */
+
+#pragma once
+
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AsmDataForward.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Process-wide cache of the inline assembly snippets appended by
+ * CompilerContext::appendInlineAssembly. Most of them are fixed helpers or sets of
+ * ABI functions that are identical across contracts, so a snippet is only parsed, analysed
+ * and optimised once and the resulting block is handed directly to the code transform
+ * afterwards.
+ *
+ * The key has to contain everything that influences the stored block, i.e. the EVM version,
+ * the optimiser settings and the local variables in addition to the source text.
+ * Since the blocks contain YulStrings, the cache is cleared together with the
+ * YulStringRepository. The standard-json interface resets the repository for every
+ * compilation unless it keeps the analysis of previous inputs, as in server mode. There,
+ * the cache is kept across compilations until the repository grows too large.
+ */
+class InlineAssemblyCache: boost::noncopyable
+{
+public:
+	struct Snippet
+	{
+		std::shared_ptr<yul::Block const> code;
+		yul::AsmAnalysisInfo analysisInfo;
+		/// Time it took to parse, analyse and optimise the snippet.
+		std::chrono::steady_clock::duration time{0};
+	};
+
+	struct Statistics
+	{
+		size_t hits = 0;
+		size_t misses = 0;
+		/// Time spent on the snippets that were not found in the cache.
+		std::chrono::steady_clock::duration timeSpent{0};
+		/// Time it took to create the snippets that were found in the cache.
+		std::chrono::steady_clock::duration timeSaved{0};
+
+		/// @returns a human-readable summary of the statistics.
+		std::string toString() const;
+	};
+
+	static InlineAssemblyCache& instance();
+
+	/// @returns the snippet stored under @a _key or nullptr if there is none.
+	std::shared_ptr<Snippet const> lookup(std::string const& _key);
+	void store(std::string _key, std::shared_ptr<Snippet const> _snippet);
+
+	/// @returns the statistics collected since the start of the process.
+	Statistics statistics() const;
+
+	/// The cache is cleared once it holds more snippets, so that long-running processes
+	/// that rarely reset the YulStringRepository do not grow without bounds.
+	static size_t constexpr c_maxSnippets = 4096;
+
+private:
+	InlineAssemblyCache();
+
+	mutable std::mutex m_mutex;
+	std::map<std::string, std::shared_ptr<Snippet const>> m_snippets;
+	Statistics m_statistics;
+};
+
+}
+}
@@ -23,6 +23,8 @@
 
 #include <liblangutil/Exceptions.h>
 
+#include <libdevcore/Common.h>
+
 #include <boost/algorithm/string/join.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 
@@ -41,12 +43,34 @@ string MultiUseYulFunctionCollector::requestedFunctions()
 
 string MultiUseYulFunctionCollector::createFunction(string const& _name, function<string ()> const& _creator)
 {
+	if (!m_dependencies.empty())
+		m_dependencies.back().push_back(_name);
 	if (!m_requestedFunctions.count(_name))
 	{
+		if (m_cache && m_cache->function(_name))
+		{
+			addCachedFunction(_name);
+			return _name;
+		}
+		m_dependencies.emplace_back();
+		ScopeGuard dependenciesGuard([&]() { m_dependencies.pop_back(); });
 		string fun = _creator();
 		solAssert(!fun.empty(), "");
 		solAssert(fun.find("function " + _name) != string::npos, "Function not properly named.");
+		if (m_cache)
+			m_cache->storeFunction(_name, {fun, move(m_dependencies.back())});
 		m_requestedFunctions[_name] = std::move(fun);
 	}
 	return _name;
 }
+
+void MultiUseYulFunctionCollector::addCachedFunction(string const& _name)
+{
+	if (m_requestedFunctions.count(_name))
+		return;
+	YulFunctionCache::Function const* function = m_cache->function(_name);
+	solAssert(function, "Dependency of cached function " + _name + " not cached.");
+	m_requestedFunctions[_name] = function->code;
+	for (string const& dependency: function->dependencies)
+		addCachedFunction(dependency);
+}
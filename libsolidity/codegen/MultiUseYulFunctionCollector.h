@@ -21,9 +21,13 @@
 
 #pragma once
 
+#include <libsolidity/codegen/YulFunctionCache.h>
+
 #include <functional>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace dev
 {
@@ -37,6 +41,13 @@ namespace solidity
 class MultiUseYulFunctionCollector
 {
 public:
+	MultiUseYulFunctionCollector() = default;
+	/// Functions that have been generated for another collector are taken from @a _cache,
+	/// together with the functions they depend on. New functions are added to @a _cache.
+	explicit MultiUseYulFunctionCollector(std::shared_ptr<YulFunctionCache> _cache):
+		m_cache(std::move(_cache))
+	{}
+
 	/// Helper function that uses @a _creator to create a function and add it to
 	/// @a m_requestedFunctions if it has not been created yet and returns @a _name in both
 	/// cases.
@@ -48,8 +59,15 @@ public:
 	std::string requestedFunctions();
 
 private:
+	/// Adds the cached function @a _name and its dependencies if they have not been added yet.
+	void addCachedFunction(std::string const& _name);
+
 	/// Map from function name to code for a multi-use function.
 	std::map<std::string, std::string> m_requestedFunctions;
+	std::shared_ptr<YulFunctionCache> m_cache;
+	/// For each function that is currently being created, the names of the functions
+	/// requested by it so far.
+	std::vector<std::vector<std::string>> m_dependencies;
 };
 
 }
@@ -0,0 +1,38 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Cache of the Yul helper functions generated for the contracts of one compilation.
+ */
+
+#include <libsolidity/codegen/YulFunctionCache.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+YulFunctionCache::Function const* YulFunctionCache::function(string const& _name) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_functions.find(_name);
+	return it == m_functions.end() ? nullptr : &it->second;
+}
+
+void YulFunctionCache::storeFunction(string const& _name, Function _function)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_functions.emplace(_name, move(_function));
+}
@@ -0,0 +1,69 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Cache of the Yul helper functions generated for the contracts of one compilation.
+ */
+
+#pragma once
+
+#include <liblangutil/EVMVersion.h>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Cache of the Yul helper functions generated by ABIFunctions and YulUtilFunctions, shared
+ * between the contracts of one compilation.
+ * Since these functions are identified by their names, the code of each function is only
+ * generated once.
+ * Only the text of the functions is kept here. The blocks they end up in are parsed, analysed
+ * and optimised only once through InlineAssemblyCache.
+ */
+class YulFunctionCache
+{
+public:
+	struct Function
+	{
+		std::string code;
+		/// Names of the functions requested while generating this function.
+		std::vector<std::string> dependencies;
+	};
+
+	explicit YulFunctionCache(langutil::EVMVersion _evmVersion): m_evmVersion(_evmVersion) {}
+
+	langutil::EVMVersion const& evmVersion() const { return m_evmVersion; }
+
+	/// @returns the function called @a _name or nullptr if it has not been generated yet.
+	/// The returned pointer stays valid for the lifetime of the cache.
+	Function const* function(std::string const& _name) const;
+	void storeFunction(std::string const& _name, Function _function);
+
+private:
+	langutil::EVMVersion m_evmVersion;
+	mutable std::mutex m_mutex;
+	std::map<std::string, Function> m_functions;
+};
+
+}
+}
@@ -20,18 +20,35 @@
 #include <libsolidity/formal/SMTPortfolio.h>
 #include <libsolidity/formal/SymbolicTypes.h>
 
+#include <libdevcore/ThreadPool.h>
+
 #include <boost/algorithm/string/replace.hpp>
 
+#include <atomic>
+#include <future>
+#include <unordered_set>
+
 using namespace std;
 using namespace dev;
 using namespace langutil;
 using namespace dev::solidity;
 
-BMC::BMC(smt::EncodingContext& _context, ErrorReporter& _errorReporter, map<h256, string> const& _smtlib2Responses):
+BMC::BMC(
+	smt::EncodingContext& _context,
+	ErrorReporter& _errorReporter,
+	map<h256, string> const& _smtlib2Responses,
+	shared_ptr<smt::SMTQueryCache> _queryCache,
+	string const& _solverCommand
+):
 	SMTEncoder(_context),
 	m_outerErrorReporter(_errorReporter),
-	m_interface(make_shared<smt::SMTPortfolio>(_smtlib2Responses))
+	m_smtlib2Responses(_smtlib2Responses),
+	m_queryCache(move(_queryCache)),
+	m_solverCommand(_solverCommand)
 {
+	// The queries are answered by the solvers of answerDeferredQueries, so this portfolio does
+	// not need the solver process.
+	m_interface = make_shared<smt::SMTPortfolio>(_smtlib2Responses);
 #if defined (HAVE_Z3) || defined (HAVE_CVC4)
 	if (!_smtlib2Responses.empty())
 		m_errorReporter.warning(
@@ -54,12 +71,13 @@ void BMC::analyze(SourceUnit const& _source, set<Expression const*> _safeAsserti
 	m_variableUsage.setFunctionInlining(true);
 
 	_source.accept(*this);
+	answerDeferredQueries();
 
 	solAssert(m_interface->solvers() > 0, "");
 	// If this check is true, Z3 and CVC4 are not available
 	// and the query answers were not provided, since SMTPortfolio
 	// guarantees that SmtLib2Interface is the first solver.
-	if (!m_interface->unhandledQueries().empty() && m_interface->solvers() == 1)
+	if (!unhandledQueries().empty() && m_interface->solvers() == 1)
 	{
 		if (!m_noSolverWarning)
 		{
@@ -698,6 +716,132 @@ void BMC::addVerificationTarget(
 
 /// Solving.
 
+namespace
+{
+
+/// Queries @a _solver and stores the description of a solver error in @a _error
+/// instead of throwing it.
+pair<smt::CheckResult, vector<string>> querySolver(
+	smt::SolverInterface& _solver,
+	vector<smt::Expression> const& _expressionsToEvaluate,
+	boost::optional<string>& _error
+)
+{
+	try
+	{
+		return _solver.check(_expressionsToEvaluate);
+	}
+	catch (smt::SolverError const& _e)
+	{
+		_error = string("Error querying SMT solver");
+		if (_e.comment())
+			*_error += ": " + *_e.comment();
+		return {smt::CheckResult::ERROR, {}};
+	}
+}
+
+}
+
+void BMC::checkQueries(
+	vector<pair<smt::Expression, vector<smt::Expression>>> _queries,
+	function<void(vector<QueryResult> const&)> _report
+)
+{
+	m_deferredChecks.push_back({m_queries.size(), _queries.size(), m_errorReporter.errors().size(), move(_report)});
+	for (auto& query: _queries)
+	{
+		vector<smt::Expression> expressions = query.second;
+		expressions.push_back(query.first);
+		m_queries.push_back({declarations(expressions), move(query.first), move(query.second), {}, {}, {}});
+	}
+}
+
+void BMC::answerDeferredQueries()
+{
+	if (m_deferredChecks.empty())
+		return;
+
+	// Every thread answers queries with its own solvers until none are left. The solvers are
+	// renewed for every query, so that the results do not depend on which queries the thread
+	// answered before and are the same for any number of threads.
+	atomic<size_t> nextQuery{0};
+	auto answerQueries = [&]()
+	{
+		smt::SMTPortfolio solver(m_smtlib2Responses, m_solverCommand);
+		solver.setQueryCache(m_queryCache);
+		solver.setWaitForAllSolvers(m_waitForAllSolvers);
+		for (size_t index = nextQuery++; index < m_queries.size(); index = nextQuery++)
+		{
+			Query& query = m_queries[index];
+			solver.renew();
+			for (auto const& declaration: query.declarations)
+				solver.declareVariable(declaration.first, *declaration.second);
+			solver.addAssertion(query.assertion);
+			size_t const unhandledQueries = solver.unhandledQueries().size();
+			query.result = querySolver(solver, query.expressionsToEvaluate, query.solverError);
+			vector<string> allUnhandledQueries = solver.unhandledQueries();
+			query.unhandledQueries.assign(allUnhandledQueries.begin() + unhandledQueries, allUnhandledQueries.end());
+		}
+	};
+	size_t const threads = min<size_t>(m_parallelism, m_queries.size());
+	if (threads <= 1)
+		answerQueries();
+	else
+	{
+		ThreadPool pool(threads);
+		vector<future<void>> answered;
+		for (size_t i = 0; i < threads; ++i)
+			answered.emplace_back(pool.submit(answerQueries));
+		for (auto& future: answered)
+			future.get();
+	}
+
+	// Insert the reports of the checks between the other warnings at the positions at which
+	// the checks were requested.
+	ErrorList const errors = m_errorReporter.errors();
+	m_errorReporter.clear();
+	size_t position = 0;
+	for (DeferredCheck const& check: m_deferredChecks)
+	{
+		m_errorReporter.append(ErrorList(errors.begin() + position, errors.begin() + check.errorPosition));
+		position = check.errorPosition;
+
+		vector<QueryResult> results;
+		for (size_t index = check.firstQuery; index < check.firstQuery + check.queryCount; ++index)
+		{
+			Query& query = m_queries[index];
+			m_unhandledQueries += query.unhandledQueries;
+			results.emplace_back(processResult(move(query.result), query.solverError));
+		}
+		check.report(results);
+	}
+	m_errorReporter.append(ErrorList(errors.begin() + position, errors.end()));
+
+	m_queries.clear();
+	m_deferredChecks.clear();
+}
+
+vector<pair<string, smt::SortPointer>> BMC::declarations(vector<smt::Expression> const& _expressions) const
+{
+	vector<pair<string, smt::SortPointer>> declarations;
+	set<string> declaredNames;
+	unordered_set<smt::Expression, smt::ExpressionHash, smt::ExpressionIdentical> visited;
+	vector<smt::Expression> toVisit = _expressions;
+	while (!toVisit.empty())
+	{
+		smt::Expression expression = move(toVisit.back());
+		toVisit.pop_back();
+		if (!visited.insert(expression).second)
+			continue;
+		if (smt::SortPointer sort = m_context.declaredSort(expression.name()))
+			if (declaredNames.insert(expression.name()).second)
+				declarations.emplace_back(expression.name(), move(sort));
+		for (smt::Expression const& argument: expression.arguments())
+			toVisit.push_back(argument);
+	}
+	return declarations;
+}
+
 void BMC::checkCondition(
 	smt::Expression _condition,
 	vector<SMTEncoder::CallStackEntry> const& callStack,
@@ -708,9 +852,6 @@ void BMC::checkCondition(
 	smt::Expression const* _additionalValue
 )
 {
-	m_interface->push();
-	m_interface->addAssertion(_condition);
-
 	vector<smt::Expression> expressionsToEvaluate;
 	vector<string> expressionNames;
 	tie(expressionsToEvaluate, expressionNames) = _modelExpressions;
@@ -720,9 +861,6 @@ void BMC::checkCondition(
 			expressionsToEvaluate.emplace_back(*_additionalValue);
 			expressionNames.push_back(_additionalValueName);
 		}
-	smt::CheckResult result;
-	vector<string> values;
-	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
 
 	string extraComment = SMTEncoder::extraComment();
 	if (m_loopExecutionHappened)
@@ -736,24 +874,44 @@ void BMC::checkCondition(
 			" This is due to the possibility that the actual called contract"
 			" has the same ABI but implements the function differently.";
 
+	checkQueries(
+		{{move(_condition), expressionsToEvaluate}},
+		[=](vector<QueryResult> const& _results)
+		{
+			reportCondition(_results.front(), expressionsToEvaluate, expressionNames, callStack, _location, _description, extraComment);
+		}
+	);
+}
+
+void BMC::reportCondition(
+	QueryResult const& _result,
+	vector<smt::Expression> const& _expressionsToEvaluate,
+	vector<string> const& _expressionNames,
+	vector<CallStackEntry> const& _callStack,
+	SourceLocation const& _location,
+	string const& _description,
+	string const& _extraComment
+)
+{
 	SecondarySourceLocation secondaryLocation{};
-	secondaryLocation.append(extraComment, SourceLocation{});
+	secondaryLocation.append(_extraComment, SourceLocation{});
 
-	switch (result)
+	vector<string> const& values = _result.second;
+	switch (_result.first)
 	{
 	case smt::CheckResult::SATISFIABLE:
 	{
 		std::ostringstream message;
 		message << _description << " happens here";
-		if (callStack.size())
+		if (_callStack.size())
 		{
 			std::ostringstream modelMessage;
 			modelMessage << "  for:\n";
-			solAssert(values.size() == expressionNames.size(), "");
+			solAssert(values.size() == _expressionNames.size(), "");
 			map<string, string> sortedModel;
 			for (size_t i = 0; i < values.size(); ++i)
-				if (expressionsToEvaluate.at(i).name != values.at(i))
-					sortedModel[expressionNames.at(i)] = values.at(i);
+				if (_expressionsToEvaluate.at(i).name() != values.at(i))
+					sortedModel[_expressionNames.at(i)] = values.at(i);
 
 			for (auto const& eval: sortedModel)
 				modelMessage << "  " << eval.first << " = " << eval.second << "\n";
@@ -761,7 +919,7 @@ void BMC::checkCondition(
 				_location,
 				message.str(),
 				SecondarySourceLocation().append(modelMessage.str(), SourceLocation{})
-				.append(SMTEncoder::callStackMessage(callStack))
+				.append(SMTEncoder::callStackMessage(_callStack))
 				.append(move(secondaryLocation))
 			);
 		}
@@ -784,8 +942,6 @@ void BMC::checkCondition(
 		m_errorReporter.warning(_location, "Error trying to invoke SMT solver.");
 		break;
 	}
-
-	m_interface->pop();
 }
 
 void BMC::checkBooleanNotConstant(
@@ -800,42 +956,49 @@ void BMC::checkBooleanNotConstant(
 	if (dynamic_cast<Literal const*>(&_condition))
 		return;
 
-	m_interface->push();
-	m_interface->addAssertion(_constraints && _value);
-	auto positiveResult = checkSatisfiable();
-	m_interface->pop();
-
-	m_interface->push();
-	m_interface->addAssertion(_constraints && !_value);
-	auto negatedResult = checkSatisfiable();
-	m_interface->pop();
+	checkQueries(
+		{{_constraints && _value, {}}, {_constraints && !_value, {}}},
+		[=, &_condition](vector<QueryResult> const& _results)
+		{
+			reportBooleanNotConstant(_results.at(0).first, _results.at(1).first, _condition, _callStack, _description);
+		}
+	);
+}
 
-	if (positiveResult == smt::CheckResult::ERROR || negatedResult == smt::CheckResult::ERROR)
+void BMC::reportBooleanNotConstant(
+	smt::CheckResult _positiveResult,
+	smt::CheckResult _negatedResult,
+	Expression const& _condition,
+	vector<CallStackEntry> const& _callStack,
+	string const& _description
+)
+{
+	if (_positiveResult == smt::CheckResult::ERROR || _negatedResult == smt::CheckResult::ERROR)
 		m_errorReporter.warning(_condition.location(), "Error trying to invoke SMT solver.");
-	else if (positiveResult == smt::CheckResult::CONFLICTING || negatedResult == smt::CheckResult::CONFLICTING)
+	else if (_positiveResult == smt::CheckResult::CONFLICTING || _negatedResult == smt::CheckResult::CONFLICTING)
 		m_errorReporter.warning(_condition.location(), "At least two SMT solvers provided conflicting answers. Results might not be sound.");
-	else if (positiveResult == smt::CheckResult::SATISFIABLE && negatedResult == smt::CheckResult::SATISFIABLE)
+	else if (_positiveResult == smt::CheckResult::SATISFIABLE && _negatedResult == smt::CheckResult::SATISFIABLE)
 	{
 		// everything fine.
 	}
-	else if (positiveResult == smt::CheckResult::UNKNOWN || negatedResult == smt::CheckResult::UNKNOWN)
+	else if (_positiveResult == smt::CheckResult::UNKNOWN || _negatedResult == smt::CheckResult::UNKNOWN)
 	{
 		// can't do anything.
 	}
-	else if (positiveResult == smt::CheckResult::UNSATISFIABLE && negatedResult == smt::CheckResult::UNSATISFIABLE)
+	else if (_positiveResult == smt::CheckResult::UNSATISFIABLE && _negatedResult == smt::CheckResult::UNSATISFIABLE)
 		m_errorReporter.warning(_condition.location(), "Condition unreachable.", SMTEncoder::callStackMessage(_callStack));
 	else
 	{
 		string value;
-		if (positiveResult == smt::CheckResult::SATISFIABLE)
+		if (_positiveResult == smt::CheckResult::SATISFIABLE)
 		{
-			solAssert(negatedResult == smt::CheckResult::UNSATISFIABLE, "");
+			solAssert(_negatedResult == smt::CheckResult::UNSATISFIABLE, "");
 			value = "true";
 		}
 		else
 		{
-			solAssert(positiveResult == smt::CheckResult::UNSATISFIABLE, "");
-			solAssert(negatedResult == smt::CheckResult::SATISFIABLE, "");
+			solAssert(_positiveResult == smt::CheckResult::UNSATISFIABLE, "");
+			solAssert(_negatedResult == smt::CheckResult::SATISFIABLE, "");
 			value = "false";
 		}
 		m_errorReporter.warning(
@@ -846,25 +1009,12 @@ void BMC::checkBooleanNotConstant(
 	}
 }
 
-pair<smt::CheckResult, vector<string>>
-BMC::checkSatisfiableAndGenerateModel(vector<smt::Expression> const& _expressionsToEvaluate)
+BMC::QueryResult BMC::processResult(QueryResult _result, boost::optional<string> const& _solverError)
 {
-	smt::CheckResult result;
-	vector<string> values;
-	try
-	{
-		tie(result, values) = m_interface->check(_expressionsToEvaluate);
-	}
-	catch (smt::SolverError const& _e)
-	{
-		string description("Error querying SMT solver");
-		if (_e.comment())
-			description += ": " + *_e.comment();
-		m_errorReporter.warning(description);
-		result = smt::CheckResult::ERROR;
-	}
+	if (_solverError)
+		m_errorReporter.warning(*_solverError);
 
-	for (string& value: values)
+	for (string& value: _result.second)
 	{
 		try
 		{
@@ -874,11 +1024,6 @@ BMC::checkSatisfiableAndGenerateModel(vector<smt::Expression> const& _expression
 		catch (...) { }
 	}
 
-	return make_pair(result, values);
-}
-
-smt::CheckResult BMC::checkSatisfiable()
-{
-	return checkSatisfiableAndGenerateModel({}).first;
+	return _result;
 }
 
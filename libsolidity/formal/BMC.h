@@ -35,6 +35,9 @@
 #include <libsolidity/interface/ReadFile.h>
 #include <liblangutil/ErrorReporter.h>
 
+#include <boost/optional.hpp>
+
+#include <functional>
 #include <set>
 #include <string>
 #include <vector>
@@ -50,17 +53,36 @@ namespace dev
 namespace solidity
 {
 
+namespace smt
+{
+class SMTQueryCache;
+}
+
 class BMC: public SMTEncoder
 {
 public:
-	BMC(smt::EncodingContext& _context, langutil::ErrorReporter& _errorReporter, std::map<h256, std::string> const& _smtlib2Responses);
+	BMC(
+		smt::EncodingContext& _context,
+		langutil::ErrorReporter& _errorReporter,
+		std::map<h256, std::string> const& _smtlib2Responses,
+		std::shared_ptr<smt::SMTQueryCache> _queryCache = nullptr,
+		std::string const& _solverCommand = std::string()
+	);
 
 	void analyze(SourceUnit const& _sources, std::set<Expression const*> _safeAssertions);
 
+	/// Sets the number of solvers that answer queries concurrently. The queries of an analysis
+	/// are collected and answered at its end, each by solvers in their initial state, so the
+	/// warnings and counterexamples do not depend on the number of solvers.
+	void setParallelism(unsigned _jobs) { m_parallelism = _jobs; }
+	/// Lets every query wait for the answers of all solvers instead of using the first answer,
+	/// so that conflicting answers of the solvers are reported.
+	void setWaitForAllSolvers(bool _wait) { m_waitForAllSolvers = _wait; }
+
 	/// This is used if the SMT solver is not directly linked into this binary.
 	/// @returns a list of inputs to the SMT solver that were not part of the argument to
 	/// the constructor.
-	std::vector<std::string> unhandledQueries() { return m_interface->unhandledQueries(); }
+	std::vector<std::string> unhandledQueries() { return m_unhandledQueries; }
 
 	/// @returns true if _funCall should be inlined, otherwise false.
 	static bool shouldInlineFunctionCall(FunctionCall const& _funCall);
@@ -140,6 +162,43 @@ private:
 
 	/// Solver related.
 	//@{
+	using QueryResult = std::pair<smt::CheckResult, std::vector<std::string>>;
+
+	/// Satisfiability query that is answered at the end of the analysis.
+	struct Query
+	{
+		/// Variables and functions used by the query.
+		std::vector<std::pair<std::string, smt::SortPointer>> declarations;
+		smt::Expression assertion;
+		std::vector<smt::Expression> expressionsToEvaluate;
+		QueryResult result;
+		/// Description of the error thrown by the solver, if any.
+		boost::optional<std::string> solverError;
+		std::vector<std::string> unhandledQueries;
+	};
+	/// Consecutive queries whose results are reported together.
+	struct DeferredCheck
+	{
+		size_t firstQuery;
+		size_t queryCount;
+		/// Number of errors that were reported before the check was requested.
+		size_t errorPosition;
+		std::function<void(std::vector<QueryResult> const&)> report;
+	};
+
+	/// Checks the satisfiability of each assertion of @a _queries and evaluates the
+	/// corresponding expressions. Calls @a _report with the results, which only happens in
+	/// answerDeferredQueries.
+	void checkQueries(
+		std::vector<std::pair<smt::Expression, std::vector<smt::Expression>>> _queries,
+		std::function<void(std::vector<QueryResult> const&)> _report
+	);
+	/// Answers the collected queries concurrently and reports their results in the order in
+	/// which the checks were requested.
+	void answerDeferredQueries();
+	/// @returns the variables and functions used by @a _expressions.
+	std::vector<std::pair<std::string, smt::SortPointer>> declarations(std::vector<smt::Expression> const& _expressions) const;
+
 	/// Check that a condition can be satisfied.
 	void checkCondition(
 		smt::Expression _condition,
@@ -160,10 +219,26 @@ private:
 		std::vector<CallStackEntry> const& _callStack,
 		std::string const& _description
 	);
-	std::pair<smt::CheckResult, std::vector<std::string>>
-	checkSatisfiableAndGenerateModel(std::vector<smt::Expression> const& _expressionsToEvaluate);
-
-	smt::CheckResult checkSatisfiable();
+	/// Reports the result of a check created by checkCondition.
+	void reportCondition(
+		QueryResult const& _result,
+		std::vector<smt::Expression> const& _expressionsToEvaluate,
+		std::vector<std::string> const& _expressionNames,
+		std::vector<CallStackEntry> const& _callStack,
+		langutil::SourceLocation const& _location,
+		std::string const& _description,
+		std::string const& _extraComment
+	);
+	/// Reports the results of a check created by checkBooleanNotConstant.
+	void reportBooleanNotConstant(
+		smt::CheckResult _positiveResult,
+		smt::CheckResult _negatedResult,
+		Expression const& _condition,
+		std::vector<CallStackEntry> const& _callStack,
+		std::string const& _description
+	);
+	/// Reports @a _solverError and formats the values of @a _result.
+	QueryResult processResult(QueryResult _result, boost::optional<std::string> const& _solverError);
 	//@}
 
 	/// Flags used for better warning messages.
@@ -179,6 +254,18 @@ private:
 	std::set<Expression const*> m_safeAssertions;
 
 	std::shared_ptr<smt::SolverInterface> m_interface;
+
+	/// Used to create the solvers that answer the queries.
+	std::map<h256, std::string> const& m_smtlib2Responses;
+	std::shared_ptr<smt::SMTQueryCache> m_queryCache;
+	/// The SMT-LIB2 solver binary that answers queries, if any.
+	std::string const m_solverCommand;
+	unsigned m_parallelism = 1;
+	bool m_waitForAllSolvers = false;
+	std::vector<Query> m_queries;
+	std::vector<DeferredCheck> m_deferredChecks;
+	/// Queries that the SMT-LIB2 interface could not answer.
+	std::vector<std::string> m_unhandledQueries;
 };
 
 }
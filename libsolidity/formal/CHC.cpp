@@ -595,7 +595,7 @@ void CHC::connectBlocks(smt::Expression const& _from, smt::Expression const& _to
 		_from && m_context.assertions() && _constraints,
 		_to
 	);
-	addRule(edge, _from.name + "_to_" + _to.name);
+	addRule(edge, _from.name() + "_to_" + _to.name());
 }
 
 vector<smt::Expression> CHC::currentFunctionVariables()
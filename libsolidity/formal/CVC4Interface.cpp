@@ -20,6 +20,8 @@
 #include <liblangutil/Exceptions.h>
 #include <libdevcore/CommonIO.h>
 
+#include <cvc4/base/configuration.h>
+
 using namespace std;
 using namespace dev;
 using namespace dev::solidity::smt;
@@ -32,6 +34,7 @@ CVC4Interface::CVC4Interface():
 
 void CVC4Interface::reset()
 {
+	m_translations.clear();
 	m_variables.clear();
 	m_solver.reset();
 	m_solver.setOption("produce-models", true);
@@ -114,21 +117,41 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 	return make_pair(result, values);
 }
 
+void CVC4Interface::interrupt()
+{
+	m_solver.interrupt();
+}
+
+string CVC4Interface::version()
+{
+	return CVC4::Configuration::getVersionString();
+}
+
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
+{
+	auto it = m_translations.find(_expr);
+	if (it != m_translations.end())
+		return it->second;
+	CVC4::Expr result = translate(_expr);
+	m_translations.emplace(_expr, result);
+	return result;
+}
+
+CVC4::Expr CVC4Interface::translate(Expression const& _expr)
 {
 	// Variable
-	if (_expr.arguments.empty() && m_variables.count(_expr.name))
-		return m_variables.at(_expr.name);
+	if (_expr.arguments().empty() && m_variables.count(_expr.name()))
+		return m_variables.at(_expr.name());
 
 	vector<CVC4::Expr> arguments;
-	for (auto const& arg: _expr.arguments)
+	for (auto const& arg: _expr.arguments())
 		arguments.push_back(toCVC4Expr(arg));
 
 	try
 	{
-		string const& n = _expr.name;
+		string const& n = _expr.name();
 		// Function application
-		if (!arguments.empty() && m_variables.count(_expr.name))
+		if (!arguments.empty() && m_variables.count(_expr.name()))
 			return m_context.mkExpr(CVC4::kind::APPLY_UF, m_variables.at(n), arguments);
 		// Literal
 		else if (arguments.empty())
@@ -137,7 +160,7 @@ CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 				return m_context.mkConst(true);
 			else if (n == "false")
 				return m_context.mkConst(false);
-			else if (auto sortSort = dynamic_pointer_cast<SortSort>(_expr.sort))
+			else if (auto sortSort = dynamic_pointer_cast<SortSort>(_expr.sort()))
 				return m_context.mkVar(n, cvc4Sort(*sortSort->inner));
 			else
 				try
@@ -155,46 +178,51 @@ CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 		}
 
 		solAssert(_expr.hasCorrectArity(), "");
-		if (n == "ite")
+		switch (_expr.op())
+		{
+		case Operator::Ite:
 			return arguments[0].iteExpr(arguments[1], arguments[2]);
-		else if (n == "not")
+		case Operator::Not:
 			return arguments[0].notExpr();
-		else if (n == "and")
+		case Operator::And:
 			return arguments[0].andExpr(arguments[1]);
-		else if (n == "or")
+		case Operator::Or:
 			return arguments[0].orExpr(arguments[1]);
-		else if (n == "implies")
+		case Operator::Implies:
 			return m_context.mkExpr(CVC4::kind::IMPLIES, arguments[0], arguments[1]);
-		else if (n == "=")
+		case Operator::Equal:
 			return m_context.mkExpr(CVC4::kind::EQUAL, arguments[0], arguments[1]);
-		else if (n == "<")
+		case Operator::Less:
 			return m_context.mkExpr(CVC4::kind::LT, arguments[0], arguments[1]);
-		else if (n == "<=")
+		case Operator::LessOrEqual:
 			return m_context.mkExpr(CVC4::kind::LEQ, arguments[0], arguments[1]);
-		else if (n == ">")
+		case Operator::Greater:
 			return m_context.mkExpr(CVC4::kind::GT, arguments[0], arguments[1]);
-		else if (n == ">=")
+		case Operator::GreaterOrEqual:
 			return m_context.mkExpr(CVC4::kind::GEQ, arguments[0], arguments[1]);
-		else if (n == "+")
+		case Operator::Add:
 			return m_context.mkExpr(CVC4::kind::PLUS, arguments[0], arguments[1]);
-		else if (n == "-")
+		case Operator::Sub:
 			return m_context.mkExpr(CVC4::kind::MINUS, arguments[0], arguments[1]);
-		else if (n == "*")
+		case Operator::Mul:
 			return m_context.mkExpr(CVC4::kind::MULT, arguments[0], arguments[1]);
-		else if (n == "/")
+		case Operator::Div:
 			return m_context.mkExpr(CVC4::kind::INTS_DIVISION_TOTAL, arguments[0], arguments[1]);
-		else if (n == "mod")
+		case Operator::Mod:
 			return m_context.mkExpr(CVC4::kind::INTS_MODULUS, arguments[0], arguments[1]);
-		else if (n == "select")
+		case Operator::Select:
 			return m_context.mkExpr(CVC4::kind::SELECT, arguments[0], arguments[1]);
-		else if (n == "store")
+		case Operator::Store:
 			return m_context.mkExpr(CVC4::kind::STORE, arguments[0], arguments[1], arguments[2]);
-		else if (n == "const_array")
+		case Operator::ConstArray:
 		{
-			shared_ptr<SortSort> sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments[0].sort);
+			shared_ptr<SortSort> sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments()[0].sort());
 			solAssert(sortSort, "");
 			return m_context.mkConst(CVC4::ArrayStoreAll(cvc4Sort(*sortSort->inner), arguments[1]));
 		}
+		default:
+			break;
+		}
 
 		solAssert(false, "");
 	}
@@ -54,15 +54,24 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
+
+	/// @returns the version of the linked CVC4 library.
+	static std::string version();
 
 private:
 	CVC4::Expr toCVC4Expr(Expression const& _expr);
+	/// Translates @a _expr without looking it up in m_translations.
+	CVC4::Expr translate(Expression const& _expr);
 	CVC4::Type cvc4Sort(smt::Sort const& _sort);
 	std::vector<CVC4::Type> cvc4Sort(std::vector<smt::SortPointer> const& _sorts);
 
 	CVC4::ExprManager m_context;
 	CVC4::SmtEngine m_solver;
 	std::map<std::string, CVC4::Expr> m_variables;
+	/// Translations of the expressions seen since the last reset. Since expressions are shared,
+	/// this translates every subexpression only once.
+	ExpressionMap<CVC4::Expr> m_translations;
 };
 
 }
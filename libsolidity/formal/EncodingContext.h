@@ -61,8 +61,16 @@ public:
 	Expression newVariable(std::string _name, SortPointer _sort)
 	{
 		solAssert(m_solver, "");
+		m_declaredSorts[_name] = _sort;
 		return m_solver->newVariable(move(_name), move(_sort));
 	}
+	/// @returns the sort of the variable or function called @a _name or nullptr if no such
+	/// variable was created by this context.
+	SortPointer declaredSort(std::string const& _name) const
+	{
+		auto it = m_declaredSorts.find(_name);
+		return it == m_declaredSorts.end() ? nullptr : it->second;
+	}
 
 	/// Variables.
 	//@{
@@ -184,6 +192,10 @@ private:
 
 	/// Whether to conjoin assertions in the assertion stack.
 	bool m_accumulateAssertions = true;
+
+	/// Sorts of all variables ever created by this context, so that solvers other than
+	/// m_solver can declare them. Kept by clear() since the names are unique.
+	std::unordered_map<std::string, SortPointer> m_declaredSorts;
 	//@}
 };
 
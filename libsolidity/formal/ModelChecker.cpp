@@ -22,8 +22,13 @@ using namespace dev;
 using namespace langutil;
 using namespace dev::solidity;
 
-ModelChecker::ModelChecker(ErrorReporter& _errorReporter, map<h256, string> const& _smtlib2Responses):
-	m_bmc(m_context, _errorReporter, _smtlib2Responses),
+ModelChecker::ModelChecker(
+	ErrorReporter& _errorReporter,
+	map<h256, string> const& _smtlib2Responses,
+	shared_ptr<smt::SMTQueryCache> _queryCache,
+	string const& _solverCommand
+):
+	m_bmc(m_context, _errorReporter, _smtlib2Responses, move(_queryCache), _solverCommand),
 	m_chc(m_context, _errorReporter),
 	m_context()
 {
@@ -43,10 +43,24 @@ namespace solidity
 class ModelChecker
 {
 public:
-	ModelChecker(langutil::ErrorReporter& _errorReporter, std::map<h256, std::string> const& _smtlib2Responses);
+	/// @param _queryCache optional cache of answered SMT queries, which can be shared by
+	/// several model checkers.
+	/// @param _solverCommand optional SMT-LIB2 solver binary with arguments that answers
+	/// the queries that are otherwise returned as unhandled queries.
+	ModelChecker(
+		langutil::ErrorReporter& _errorReporter,
+		std::map<h256, std::string> const& _smtlib2Responses,
+		std::shared_ptr<smt::SMTQueryCache> _queryCache = nullptr,
+		std::string const& _solverCommand = std::string()
+	);
 
 	void analyze(SourceUnit const& _sources);
 
+	/// Sets the number of SMT solvers that are queried concurrently by the BMC engine.
+	void setParallelism(unsigned _jobs) { m_bmc.setParallelism(_jobs); }
+	/// Lets the BMC engine wait for the answers of all SMT solvers and report conflicting answers.
+	void setWaitForAllSolvers(bool _wait) { m_bmc.setWaitForAllSolvers(_wait); }
+
 	/// This is used if the SMT solver is not directly linked into this binary.
 	/// @returns a list of inputs to the SMT solver that were not part of the argument to
 	/// the constructor.
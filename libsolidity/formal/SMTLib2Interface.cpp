@@ -34,14 +34,44 @@ using namespace dev;
 using namespace dev::solidity;
 using namespace dev::solidity::smt;
 
-SMTLib2Interface::SMTLib2Interface(map<h256, string> const& _queryResponses):
-	m_queryResponses(_queryResponses)
+namespace
 {
+/// @returns the string value of @a _keyword in a response to get-info, e.g. 4.8.7 for
+/// (:version "4.8.7"), or an empty string if it is not there.
+string infoValue(string const& _response, string const& _keyword)
+{
+	string const prefix = "(" + _keyword + " \"";
+	size_t start = _response.find(prefix);
+	if (start == string::npos)
+		return {};
+	start += prefix.size();
+	size_t end = _response.find('"', start);
+	if (end == string::npos)
+		return {};
+	return _response.substr(start, end - start);
+}
+}
+
+SMTLib2Interface::SMTLib2Interface(
+	map<h256, string> const& _queryResponses,
+	string const& _solverCommand,
+	chrono::milliseconds _timeout
+):
+	m_queryResponses(_queryResponses),
+	m_timeout(_timeout)
+{
+	// The solver gets a quarter of the timeout to report that it gave up, so that the process
+	// is only terminated if it does not keep its timeout.
+	if (!_solverCommand.empty() && SMTLib2Process::available())
+		m_process = make_unique<SMTLib2Process>(_solverCommand, _timeout + _timeout / 4);
 	reset();
 }
 
 void SMTLib2Interface::reset()
 {
+	// The reset command also resets the options.
+	if (m_process)
+		m_process->send("(reset)\n" + m_timeoutOption);
 	m_accumulatedOutput.clear();
 	m_accumulatedOutput.emplace_back();
 	m_variables.clear();
@@ -52,12 +82,16 @@ void SMTLib2Interface::reset()
 void SMTLib2Interface::push()
 {
 	m_accumulatedOutput.emplace_back();
+	if (m_process)
+		m_process->send("(push 1)\n");
 }
 
 void SMTLib2Interface::pop()
 {
 	solAssert(!m_accumulatedOutput.empty(), "");
 	m_accumulatedOutput.pop_back();
+	if (m_process)
+		m_process->send("(pop 1)\n");
 }
 
 void SMTLib2Interface::declareVariable(string const& _name, Sort const& _sort)
@@ -100,10 +134,13 @@ void SMTLib2Interface::addAssertion(smt::Expression const& _expr)
 
 pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<smt::Expression> const& _expressionsToEvaluate)
 {
-	string response = querySolver(
-		boost::algorithm::join(m_accumulatedOutput, "\n") +
-		checkSatAndGetValuesCommand(_expressionsToEvaluate)
-	);
+	string response;
+	if (!m_process)
+		response = querySolver(query(_expressionsToEvaluate));
+	else if (auto processResponse = queryProcess(_expressionsToEvaluate))
+		response = move(*processResponse);
+	else
+		return {CheckResult::UNKNOWN, {}};
 
 	CheckResult result;
 	// TODO proper parsing
@@ -124,10 +161,10 @@ pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<smt::Expression
 
 string SMTLib2Interface::toSExpr(smt::Expression const& _expr)
 {
-	if (_expr.arguments.empty())
-		return _expr.name;
-	std::string sexpr = "(" + _expr.name;
-	for (auto const& arg: _expr.arguments)
+	if (_expr.arguments().empty())
+		return _expr.name();
+	std::string sexpr = "(" + _expr.name();
+	for (auto const& arg: _expr.arguments())
 		sexpr += " " + toSExpr(arg);
 	sexpr += ")";
 	return sexpr;
@@ -160,10 +197,33 @@ string SMTLib2Interface::toSmtLibSort(vector<SortPointer> const& _sorts)
 	return ssort;
 }
 
+void SMTLib2Interface::interrupt()
+{
+	if (m_process)
+		m_process->interrupt();
+}
+
+string SMTLib2Interface::solverVersion()
+{
+	if (!m_process)
+		return {};
+	if (!m_process->running())
+		startProcess();
+	return m_solverVersion;
+}
+
 void SMTLib2Interface::write(string _data)
 {
 	solAssert(!m_accumulatedOutput.empty(), "");
-	m_accumulatedOutput.back() += move(_data) + "\n";
+	_data += "\n";
+	if (m_process)
+		m_process->send(_data);
+	m_accumulatedOutput.back() += move(_data);
+}
+
+string SMTLib2Interface::query(vector<smt::Expression> const& _expressionsToEvaluate)
+{
+	return boost::algorithm::join(m_accumulatedOutput, "\n") + checkSatAndGetValuesCommand(_expressionsToEvaluate);
 }
 
 string SMTLib2Interface::checkSatAndGetValuesCommand(vector<smt::Expression> const& _expressionsToEvaluate)
@@ -177,8 +237,8 @@ string SMTLib2Interface::checkSatAndGetValuesCommand(vector<smt::Expression> con
 		for (size_t i = 0; i < _expressionsToEvaluate.size(); i++)
 		{
 			auto const& e = _expressionsToEvaluate.at(i);
-			solAssert(e.sort->kind == Kind::Int || e.sort->kind == Kind::Bool, "Invalid sort for expression to evaluate.");
-			command += "(declare-const |EVALEXPR_" + to_string(i) + "| " + (e.sort->kind == Kind::Int ? "Int" : "Bool") + ")\n";
+			solAssert(e.sort()->kind == Kind::Int || e.sort()->kind == Kind::Bool, "Invalid sort for expression to evaluate.");
+			command += "(declare-const |EVALEXPR_" + to_string(i) + "| " + (e.sort()->kind == Kind::Int ? "Int" : "Bool") + ")\n";
 			command += "(assert (= |EVALEXPR_" + to_string(i) + "| " + toSExpr(e) + "))\n";
 		}
 		command += "(check-sat)\n";
@@ -218,3 +278,32 @@ string SMTLib2Interface::querySolver(string const& _input)
 		return "unknown\n";
 	}
 }
+
+boost::optional<string> SMTLib2Interface::queryProcess(vector<smt::Expression> const& _expressionsToEvaluate)
+{
+	if (!m_process->running())
+		startProcess();
+	// The declarations of the evaluated expressions are removed again after the query.
+	return m_process->query("(push 1)\n" + checkSatAndGetValuesCommand(_expressionsToEvaluate) + "(pop 1)\n", true);
+}
+
+void SMTLib2Interface::startProcess()
+{
+	m_process->start();
+
+	// The version is part of the key of cached answers. The timeout option is not standardised.
+	string const info = m_process->query("(get-info :name)\n(get-info :version)\n").value_or(string());
+	string const name = infoValue(info, ":name");
+	m_solverVersion = name + " " + infoValue(info, ":version");
+	m_timeoutOption.clear();
+	if (boost::iequals(name, "z3"))
+		m_timeoutOption = "(set-option :timeout " + to_string(m_timeout.count()) + ")\n";
+	else if (boost::iequals(name, "cvc4"))
+		m_timeoutOption = "(set-option :tlimit-per " + to_string(m_timeout.count()) + ")\n";
+
+	// Restore the state of the solver, including the levels of the assertion stack.
+	string commands = m_timeoutOption + m_accumulatedOutput.front();
+	for (size_t i = 1; i < m_accumulatedOutput.size(); ++i)
+		commands += "(push 1)\n" + m_accumulatedOutput[i];
+	m_process->send(commands);
+}
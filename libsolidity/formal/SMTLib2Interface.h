@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <libsolidity/formal/SMTLib2Process.h>
 #include <libsolidity/formal/SolverInterface.h>
 
 #include <libsolidity/interface/ReadFile.h>
@@ -25,8 +26,11 @@
 #include <libdevcore/FixedHash.h>
 
 #include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+#include <chrono>
 #include <cstdio>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -38,10 +42,29 @@ namespace solidity
 namespace smt
 {
 
+/**
+ * Solver interface that produces SMT-LIB2 queries.
+ *
+ * By default, queries are answered from @a _queryResponses and all other queries are
+ * collected as unhandled queries, so that they can be answered before the next compilation.
+ *
+ * If a solver command is given and solver processes are available in this build, the queries
+ * are answered by a solver process instead. The process is kept alive and commands are sent
+ * to it incrementally as they are issued. Z3 and CVC4 are asked to give up on a query after
+ * the timeout. Queries that take longer than the timeout are aborted by terminating the
+ * process. If the process terminates, it is restarted by the next query and all commands of
+ * the current state are sent again. An interrupted query does not wait for the response of
+ * the solver, which keeps running. The result of an aborted or interrupted query is UNKNOWN.
+ */
 class SMTLib2Interface: public SolverInterface, public boost::noncopyable
 {
 public:
-	explicit SMTLib2Interface(std::map<h256, std::string> const& _queryResponses);
+	/// @param _timeout time the solver process gets for a query.
+	explicit SMTLib2Interface(
+		std::map<h256, std::string> const& _queryResponses,
+		std::string const& _solverCommand = std::string(),
+		std::chrono::milliseconds _timeout = std::chrono::milliseconds(queryTimeout)
+	);
 
 	void reset() override;
 
@@ -55,6 +78,17 @@ public:
 
 	std::vector<std::string> unhandledQueries() override { return m_unhandledQueries; }
 
+	/// Lets a query of the solver process return without waiting for the response.
+	void interrupt() override;
+
+	/// @returns the name and version the solver process reports, starting it if it is not
+	/// running. Empty if no solver command was given.
+	std::string solverVersion();
+
+	/// @returns the SMT-LIB2 input that a call to @a check with the same arguments
+	/// sends to the solver.
+	std::string query(std::vector<smt::Expression> const& _expressionsToEvaluate);
+
 private:
 	void declareFunction(std::string const&, Sort const&);
 
@@ -69,12 +103,26 @@ private:
 
 	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
 	std::string querySolver(std::string const& _input);
+	/// Sends the check command to the solver process, (re)starting it if needed.
+	/// Throws SMTSolverError if it cannot be started. @returns nothing if the query was aborted.
+	boost::optional<std::string> queryProcess(std::vector<smt::Expression> const& _expressionsToEvaluate);
+	/// Starts the solver process, asks it for its version, sets its timeout and sends the
+	/// commands of the current state to it.
+	void startProcess();
 
 	std::vector<std::string> m_accumulatedOutput;
 	std::set<std::string> m_variables;
 
 	std::map<h256, std::string> const& m_queryResponses;
 	std::vector<std::string> m_unhandledQueries;
+
+	/// The solver process, if a solver command was given.
+	std::unique_ptr<SMTLib2Process> m_process;
+	std::chrono::milliseconds const m_timeout;
+	/// Name and version of the solver, reported when the process was started.
+	std::string m_solverVersion;
+	/// Sets the timeout of the solver, if it is known how to do that.
+	std::string m_timeoutOption;
 };
 
 }
@@ -0,0 +1,355 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <libsolidity/formal/SMTLib2Process.h>
+
+#include <libsolidity/formal/SolverInterface.h>
+
+// Boost.Process is not part of the Boost build of the JavaScript compiler.
+#ifndef __EMSCRIPTEN__
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/process.hpp>
+
+#include <algorithm>
+#include <istream>
+#include <thread>
+
+#ifndef _WIN32
+#include <csignal>
+#include <pthread.h>
+#endif
+#endif
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+using namespace dev::solidity::smt;
+
+#ifdef __EMSCRIPTEN__
+
+struct SMTLib2Process::Session
+{
+};
+
+bool SMTLib2Process::available()
+{
+	return false;
+}
+
+SMTLib2Process::SMTLib2Process(string const&, chrono::milliseconds _timeout):
+	m_timeout(_timeout)
+{
+}
+
+SMTLib2Process::~SMTLib2Process() = default;
+
+bool SMTLib2Process::running()
+{
+	return false;
+}
+
+void SMTLib2Process::start()
+{
+	BOOST_THROW_EXCEPTION(SolverError() << errinfo_comment("SMT solver processes are not supported by this build."));
+}
+
+void SMTLib2Process::send(string const&)
+{
+}
+
+boost::optional<string> SMTLib2Process::query(string const&, bool)
+{
+	return string();
+}
+
+void SMTLib2Process::interrupt()
+{
+}
+
+void SMTLib2Process::terminate()
+{
+}
+
+void SMTLib2Process::readResponses(Session&)
+{
+}
+
+void SMTLib2Process::terminateSession()
+{
+}
+
+#else
+
+namespace
+{
+/// Printed by the solver with ``(echo ...)`` after each query.
+string const c_endOfResponse = "solc-end-of-response";
+
+/// Blocks SIGPIPE in the current thread while it writes to the solver, so that writing to a
+/// solver that terminated fails with EPIPE instead of killing the compiler. A SIGPIPE raised
+/// while the signal is blocked is discarded before it is unblocked again. This does not touch
+/// the signal disposition of the process, which belongs to the application using the compiler.
+class SIGPIPEBlocker: boost::noncopyable
+{
+#ifndef _WIN32
+public:
+	SIGPIPEBlocker()
+	{
+		sigemptyset(&m_signals);
+		sigaddset(&m_signals, SIGPIPE);
+		sigset_t pending;
+		sigemptyset(&pending);
+		sigpending(&pending);
+		m_wasPending = sigismember(&pending, SIGPIPE) == 1;
+		pthread_sigmask(SIG_BLOCK, &m_signals, &m_previousMask);
+	}
+	~SIGPIPEBlocker()
+	{
+		if (!m_wasPending)
+		{
+			sigset_t pending;
+			sigemptyset(&pending);
+			sigpending(&pending);
+			int signal;
+			// Does not block because the signal is pending.
+			if (sigismember(&pending, SIGPIPE) == 1)
+				sigwait(&m_signals, &signal);
+		}
+		pthread_sigmask(SIG_SETMASK, &m_previousMask, nullptr);
+	}
+
+private:
+	sigset_t m_signals;
+	sigset_t m_previousMask;
+	/// If SIGPIPE was pending before, it was not raised by us and is left alone.
+	bool m_wasPending = false;
+#endif
+};
+}
+
+struct SMTLib2Process::Session
+{
+	Session(boost::filesystem::path const& _binary, vector<string> const& _arguments):
+		child(
+			_binary,
+			boost::process::args(_arguments),
+			boost::process::std_in < input,
+			boost::process::std_out > output,
+			boost::process::std_err > boost::process::null,
+			group
+		)
+	{}
+	/// Must not be called with the mutex of the process locked, since the reader uses it.
+	~Session()
+	{
+		// Otherwise the stream flushes the rest of the input, which throws if the solver terminated.
+		input.pipe().close();
+		// Ends the output, so that the reader returns.
+		error_code error;
+		group.terminate(error);
+		if (reader.joinable())
+			reader.join();
+	}
+
+	boost::process::opstream input;
+	boost::process::ipstream output;
+	/// Contains the solver and the processes it starts, which could keep the output open.
+	boost::process::group group;
+	boost::process::child child;
+	/// Reads the output of the solver.
+	thread reader;
+	/// Number of queries sent to the solver and number of responses it completed.
+	size_t queries = 0;
+	size_t responses = 0;
+	/// The last complete response and what the solver printed after it.
+	string response;
+	string partialResponse;
+	/// Set once the output of the solver ended.
+	bool outputClosed = false;
+	/// Set once the solver terminated or was terminated.
+	bool terminated = false;
+	/// Set if the solver was terminated by SMTLib2Process.
+	bool aborted = false;
+};
+
+bool SMTLib2Process::available()
+{
+	return true;
+}
+
+SMTLib2Process::SMTLib2Process(string const& _command, chrono::milliseconds _timeout):
+	m_timeout(_timeout)
+{
+	boost::split(m_command, _command, boost::is_space(), boost::token_compress_on);
+	m_command.erase(remove(m_command.begin(), m_command.end(), string()), m_command.end());
+}
+
+SMTLib2Process::~SMTLib2Process()
+{
+	terminate();
+}
+
+bool SMTLib2Process::running()
+{
+	lock_guard<mutex> lock(m_mutex);
+	error_code error;
+	return m_session && !m_session->terminated && m_session->child.running(error);
+}
+
+void SMTLib2Process::start()
+{
+	unique_ptr<Session> previousSession;
+	{
+		lock_guard<mutex> lock(m_mutex);
+		previousSession = move(m_session);
+	}
+	previousSession.reset();
+
+	if (m_command.empty())
+		BOOST_THROW_EXCEPTION(SolverError() << errinfo_comment("No SMT solver command given."));
+
+	boost::filesystem::path binary = m_command.front();
+	if (!binary.has_parent_path())
+		binary = boost::process::search_path(m_command.front());
+	if (binary.empty())
+		BOOST_THROW_EXCEPTION(SolverError() << errinfo_comment("SMT solver \"" + m_command.front() + "\" not found."));
+
+	unique_ptr<Session> session;
+	try
+	{
+		session = make_unique<Session>(binary, vector<string>(m_command.begin() + 1, m_command.end()));
+	}
+	catch (boost::process::process_error const& _error)
+	{
+		BOOST_THROW_EXCEPTION(SolverError() << errinfo_comment(
+			"Could not start SMT solver \"" + m_command.front() + "\": " + _error.what()
+		));
+	}
+	session->reader = thread([this, session = session.get()]() { readResponses(*session); });
+	lock_guard<mutex> lock(m_mutex);
+	m_session = move(session);
+}
+
+void SMTLib2Process::send(string const& _commands)
+{
+	lock_guard<mutex> lock(m_mutex);
+	if (m_session && !m_session->terminated)
+	{
+		SIGPIPEBlocker blocker;
+		m_session->input << _commands;
+	}
+}
+
+boost::optional<string> SMTLib2Process::query(string const& _commands, bool _interruptible)
+{
+	unique_lock<mutex> lock(m_mutex);
+	if (!m_session)
+		return string();
+	Session& session = *m_session;
+	if (session.terminated)
+		return session.aborted ? boost::optional<string>() : string();
+	{
+		SIGPIPEBlocker blocker;
+		session.input << _commands << "(echo \"" << c_endOfResponse << "\")" << endl;
+	}
+	size_t const query = ++session.queries;
+	m_interruptibleQueryRunning = _interruptible;
+	m_interrupted = false;
+
+	// The responses to interrupted queries arrive first. The solver gets the full timeout for
+	// each of them.
+	size_t responses = session.responses;
+	auto deadline = chrono::steady_clock::now() + m_timeout;
+	auto waiting = [&]()
+	{
+		return session.responses < query && !session.outputClosed && !session.terminated && !m_interrupted;
+	};
+	while (waiting())
+		if (session.responses != responses)
+		{
+			responses = session.responses;
+			deadline = chrono::steady_clock::now() + m_timeout;
+		}
+		else if (m_changed.wait_until(lock, deadline) == cv_status::timeout && waiting() && session.responses == responses)
+			terminateSession();
+
+	m_interruptibleQueryRunning = false;
+	bool const interrupted = m_interrupted;
+	m_interrupted = false;
+	if (session.responses >= query)
+		return session.response;
+	if (session.aborted || interrupted)
+		return boost::none;
+	// The solver terminated, it is restarted by the next call to start.
+	session.terminated = true;
+	return session.partialResponse;
+}
+
+void SMTLib2Process::interrupt()
+{
+	lock_guard<mutex> lock(m_mutex);
+	if (m_interruptibleQueryRunning)
+	{
+		m_interrupted = true;
+		m_changed.notify_all();
+	}
+}
+
+void SMTLib2Process::terminate()
+{
+	lock_guard<mutex> lock(m_mutex);
+	terminateSession();
+}
+
+void SMTLib2Process::readResponses(Session& _session)
+{
+	string line;
+	while (getline(_session.output, line))
+	{
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		lock_guard<mutex> lock(m_mutex);
+		// Some solvers keep the quotes of the echoed string.
+		if (line == c_endOfResponse || line == "\"" + c_endOfResponse + "\"")
+		{
+			_session.response = move(_session.partialResponse);
+			_session.partialResponse.clear();
+			_session.responses++;
+			m_changed.notify_all();
+		}
+		else
+			_session.partialResponse += line + "\n";
+	}
+	lock_guard<mutex> lock(m_mutex);
+	_session.outputClosed = true;
+	m_changed.notify_all();
+}
+
+void SMTLib2Process::terminateSession()
+{
+	if (m_session && !m_session->terminated)
+	{
+		m_session->terminated = true;
+		m_session->aborted = true;
+		error_code error;
+		m_session->group.terminate(error);
+		m_changed.notify_all();
+	}
+}
+
+#endif
@@ -0,0 +1,110 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Session with an SMT-LIB2 solver that runs in a separate process.
+ */
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+namespace smt
+{
+
+/**
+ * Runs an SMT-LIB2 solver binary (z3, cvc4, yices-smt2, ...) and talks to it through its
+ * standard input and output. The process is started on demand and kept alive, so that
+ * commands can be sent incrementally.
+ *
+ * The solver has to read SMT-LIB2 commands from its standard input and support
+ * ``(echo ...)``, which is used to find the end of its responses. Its output is read by a
+ * separate thread, so that waiting for a response can be given up without killing the solver.
+ *
+ * A query that takes longer than the timeout is aborted by terminating the solver, since
+ * solvers do not reliably stop at the timeout they are asked to keep. @a interrupt can be
+ * called from another thread to stop waiting for the response of a running query instead.
+ * The solver keeps running and the next query waits for both responses.
+ *
+ * Solver processes are not available in the JavaScript build.
+ */
+class SMTLib2Process: public boost::noncopyable
+{
+public:
+	/// @returns false if solver processes cannot be started in this build.
+	static bool available();
+
+	/// @param _command the solver binary followed by its arguments, separated by whitespace.
+	/// The binary is looked up in PATH unless it contains a path.
+	/// @param _timeout time after which a query is aborted.
+	SMTLib2Process(std::string const& _command, std::chrono::milliseconds _timeout);
+	~SMTLib2Process();
+
+	/// @returns true if the solver process is alive, i.e. it was started and has not
+	/// terminated since.
+	bool running();
+	/// Starts a new solver process. Throws SolverError if it cannot be started.
+	void start();
+	/// Sends @a _commands to the solver without waiting for a response.
+	/// Does nothing if the solver is not running.
+	void send(std::string const& _commands);
+	/// Sends @a _commands to the solver and @returns everything it printed in response.
+	/// If the solver terminates by itself before it responded completely, the response is
+	/// truncated. If the query is aborted, because it timed out, the solver was terminated
+	/// or the query was interrupted, nothing is returned.
+	/// @param _interruptible whether @a interrupt applies to this query.
+	boost::optional<std::string> query(std::string const& _commands, bool _interruptible = false);
+	/// Lets a running interruptible query return without waiting for its response.
+	/// Does nothing if no such query is running.
+	void interrupt();
+	/// Kills the solver process.
+	void terminate();
+
+private:
+	struct Session;
+
+	/// Reads the output of the solver of @a _session until it ends.
+	void readResponses(Session& _session);
+	/// Kills the solver process. m_mutex has to be locked.
+	void terminateSession();
+
+	std::vector<std::string> m_command;
+	std::chrono::milliseconds const m_timeout;
+	/// Guards m_session and the state of the query, so that terminate and interrupt can be
+	/// called concurrently.
+	std::mutex m_mutex;
+	/// Notified when the solver responded or terminated and when a query is interrupted.
+	std::condition_variable m_changed;
+	std::unique_ptr<Session> m_session;
+	bool m_interruptibleQueryRunning = false;
+	bool m_interrupted = false;
+};
+
+}
+}
+}
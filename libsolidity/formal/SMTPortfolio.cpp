@@ -24,21 +24,46 @@
 #include <libsolidity/formal/CVC4Interface.h>
 #endif
 #include <libsolidity/formal/SMTLib2Interface.h>
+#include <libsolidity/formal/SMTQueryCache.h>
+#include <libsolidity/interface/Version.h>
+
+#include <libdevcore/Keccak256.h>
+
+#include <boost/optional.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
 
 using namespace std;
 using namespace dev;
 using namespace dev::solidity;
 using namespace dev::solidity::smt;
 
-SMTPortfolio::SMTPortfolio(map<h256, string> const& _smtlib2Responses)
+SMTPortfolio::SMTPortfolio(
+	map<h256, string> const& _smtlib2Responses,
+	string const& _solverCommand
+):
+	m_solverCommand(_solverCommand)
 {
-	m_solvers.emplace_back(make_unique<smt::SMTLib2Interface>(_smtlib2Responses));
-#ifdef HAVE_Z3
-	m_solvers.emplace_back(make_unique<smt::Z3Interface>());
-#endif
-#ifdef HAVE_CVC4
-	m_solvers.emplace_back(make_unique<smt::CVC4Interface>());
-#endif
+	auto smtlib2 = make_unique<smt::SMTLib2Interface>(_smtlib2Responses, _solverCommand);
+	m_smtlib2 = smtlib2.get();
+	m_solvers.emplace_back(move(smtlib2));
+	addLinkedSolvers();
+}
+
+SMTPortfolio::SMTPortfolio(
+	map<h256, string> const& _smtlib2Responses,
+	vector<unique_ptr<smt::SolverInterface>> _solvers
+)
+{
+	auto smtlib2 = make_unique<smt::SMTLib2Interface>(_smtlib2Responses);
+	m_smtlib2 = smtlib2.get();
+	m_solvers.emplace_back(move(smtlib2));
+	for (auto& solver: _solvers)
+		m_solvers.emplace_back(move(solver));
+	m_linkedSolvers = false;
 }
 
 void SMTPortfolio::reset()
@@ -47,6 +72,27 @@ void SMTPortfolio::reset()
 		s->reset();
 }
 
+void SMTPortfolio::renew()
+{
+	if (m_linkedSolvers)
+	{
+		// Resetting Z3 and CVC4 keeps their contexts, which influence the models they choose.
+		m_solvers.resize(1);
+		addLinkedSolvers();
+	}
+	reset();
+}
+
+void SMTPortfolio::addLinkedSolvers()
+{
+#ifdef HAVE_Z3
+	m_solvers.emplace_back(make_unique<smt::Z3Interface>());
+#endif
+#ifdef HAVE_CVC4
+	m_solvers.emplace_back(make_unique<smt::CVC4Interface>());
+#endif
+}
+
 void SMTPortfolio::push()
 {
 	for (auto const& s: m_solvers)
@@ -100,8 +146,39 @@ void SMTPortfolio::addAssertion(smt::Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * Unless the portfolio waits for all solvers, the query is sent to all solvers concurrently
+ * and only one answer is taken into account. If the first answer is UNSAT, or SAT for a query
+ * without expressions to evaluate, it is used right away, since solvers that agree give the
+ * same answer. Otherwise, the answer of the first solver in the portfolio that answers is used.
+ * The solvers before it are never interrupted, so the values do not depend on which solver is
+ * the fastest. Conflicting answers are only detected if the portfolio waits for all solvers.
+ *
+ * Answers are stored in the query cache, if there is one, and later identical queries
+ * are answered from there.
 */
 pair<CheckResult, vector<string>> SMTPortfolio::check(vector<smt::Expression> const& _expressionsToEvaluate)
+{
+	h256 key;
+	if (m_queryCache)
+	{
+		key = queryCacheKey(_expressionsToEvaluate);
+		if (auto cached = m_queryCache->lookup(key))
+			return *cached;
+	}
+
+	pair<CheckResult, vector<string>> result;
+	if (m_waitForAllSolvers || m_solvers.size() < 2)
+		result = checkAll(_expressionsToEvaluate);
+	else
+		result = race(_expressionsToEvaluate);
+
+	if (m_queryCache)
+		m_queryCache->store(key, result);
+	return result;
+}
+
+pair<CheckResult, vector<string>> SMTPortfolio::checkAll(vector<smt::Expression> const& _expressionsToEvaluate)
 {
 	CheckResult lastResult = CheckResult::ERROR;
 	vector<string> finalValues;
@@ -129,6 +206,90 @@ pair<CheckResult, vector<string>> SMTPortfolio::check(vector<smt::Expression> co
 	return make_pair(lastResult, finalValues);
 }
 
+pair<CheckResult, vector<string>> SMTPortfolio::race(vector<smt::Expression> const& _expressionsToEvaluate)
+{
+	if (!m_threadPool)
+		m_threadPool = make_unique<ThreadPool>(m_solvers.size());
+
+	mutex resultMutex;
+	condition_variable resultAvailable;
+	vector<pair<CheckResult, vector<string>>> results(m_solvers.size());
+	vector<bool> finished(m_solvers.size(), false);
+	size_t finishedCount = 0;
+	size_t firstDecisiveAnswer = m_solvers.size();
+	exception_ptr exception;
+
+	vector<future<void>> tasks;
+	for (size_t i = 0; i < m_solvers.size(); ++i)
+		tasks.emplace_back(m_threadPool->submit([&, i]()
+		{
+			pair<CheckResult, vector<string>> result{CheckResult::ERROR, {}};
+			exception_ptr solverException;
+			try
+			{
+				result = m_solvers[i]->check(_expressionsToEvaluate);
+			}
+			catch (...)
+			{
+				solverException = current_exception();
+			}
+			lock_guard<mutex> lock(resultMutex);
+			bool decisive =
+				result.first == CheckResult::UNSATISFIABLE ||
+				(result.first == CheckResult::SATISFIABLE && _expressionsToEvaluate.empty());
+			if (decisive && firstDecisiveAnswer == m_solvers.size())
+				firstDecisiveAnswer = i;
+			results[i] = move(result);
+			finished[i] = true;
+			finishedCount++;
+			if (solverException && !exception)
+				exception = solverException;
+			resultAvailable.notify_all();
+		}));
+
+	// @returns the solver whose answer is used, the number of solvers if none of them answered,
+	// or nothing if the result is not decided yet. Otherwise, the result is decided once all
+	// solvers before the first one that answered have finished.
+	auto decidingSolver = [&]() -> boost::optional<size_t>
+	{
+		if (firstDecisiveAnswer < m_solvers.size())
+			return firstDecisiveAnswer;
+		for (size_t i = 0; i < m_solvers.size(); ++i)
+			if (!finished[i])
+				return boost::none;
+			else if (solverAnswered(results[i].first))
+				return i;
+		return m_solvers.size();
+	};
+	boost::optional<size_t> decision;
+	{
+		unique_lock<mutex> lock(resultMutex);
+		resultAvailable.wait(lock, [&]() { return bool(decision = decidingSolver()); });
+		// The solvers cannot be used again before they return. An interruption has no effect
+		// if it arrives before the solver started the query, so it is repeated.
+		while (finishedCount < m_solvers.size())
+		{
+			for (size_t i = 0; i < m_solvers.size(); ++i)
+				if (!finished[i])
+					m_solvers[i]->interrupt();
+			resultAvailable.wait_for(lock, chrono::milliseconds(10));
+		}
+	}
+	for (auto& task: tasks)
+		task.get();
+	if (exception)
+		rethrow_exception(exception);
+
+	if (*decision < m_solvers.size())
+		return move(results[*decision]);
+	// No solver answered, so none of them was interrupted.
+	CheckResult finalResult = CheckResult::ERROR;
+	for (auto const& result: results)
+		if (result.first == CheckResult::UNKNOWN)
+			finalResult = CheckResult::UNKNOWN;
+	return make_pair(finalResult, vector<string>{});
+}
+
 vector<string> SMTPortfolio::unhandledQueries()
 {
 	// This code assumes that the constructor guarantees that
@@ -142,3 +303,22 @@ bool SMTPortfolio::solverAnswered(CheckResult result)
 {
 	return result == CheckResult::SATISFIABLE || result == CheckResult::UNSATISFIABLE;
 }
+
+h256 SMTPortfolio::queryCacheKey(vector<smt::Expression> const& _expressionsToEvaluate)
+{
+	// The answers and especially the models can change between versions of the solvers and of
+	// the encoding and depend on how the answers of the solvers are combined, so these are part
+	// of the key.
+	string solvers = "solc-" + VersionString + ",smtlib2";
+	if (!m_solverCommand.empty())
+		solvers += "(" + m_solverCommand + "," + m_smtlib2->solverVersion() + ")";
+	if (m_waitForAllSolvers)
+		solvers += ",all";
+#ifdef HAVE_Z3
+	solvers += ",z3-" + smt::Z3Interface::version();
+#endif
+#ifdef HAVE_CVC4
+	solvers += ",cvc4-" + smt::CVC4Interface::version();
+#endif
+	return keccak256(solvers + "\n" + to_string(queryTimeout) + "\n" + m_smtlib2->query(_expressionsToEvaluate));
+}
@@ -21,9 +21,11 @@
 #include <libsolidity/formal/SolverInterface.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libdevcore/FixedHash.h>
+#include <libdevcore/ThreadPool.h>
 
 #include <boost/noncopyable.hpp>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace dev
@@ -33,18 +35,42 @@ namespace solidity
 namespace smt
 {
 
+class SMTLib2Interface;
+class SMTQueryCache;
+
 /**
  * The SMTPortfolio wraps all available solvers within a single interface,
  * propagating the functionalities to all solvers.
- * It also checks whether different solvers give conflicting answers
- * to SMT queries.
+ *
+ * By default, queries are sent to all solvers concurrently. The first answer decides queries
+ * that are unsatisfiable or do not ask for values. Otherwise, the answer of the first solver in
+ * the portfolio that answers is used, so that the values do not depend on which solver is the
+ * fastest. The solvers that are still running are then interrupted. If requested, the portfolio
+ * waits for all solvers instead and checks whether they give conflicting answers to SMT queries.
+ *
+ * If a query cache is set, answers are looked up there before any solver is queried.
+ *
+ * If a solver command is given, the SMT-LIB2 interface sends its queries to that solver
+ * binary instead of collecting them as unhandled queries.
  */
 class SMTPortfolio: public SolverInterface, public boost::noncopyable
 {
 public:
-	SMTPortfolio(std::map<h256, std::string> const& _smtlib2Responses);
+	SMTPortfolio(
+		std::map<h256, std::string> const& _smtlib2Responses,
+		std::string const& _solverCommand = std::string()
+	);
+	/// Creates a portfolio of the SMT-LIB2 interface followed by @a _solvers instead of the
+	/// solvers linked into this binary. Answers of this portfolio must not be cached.
+	SMTPortfolio(
+		std::map<h256, std::string> const& _smtlib2Responses,
+		std::vector<std::unique_ptr<smt::SolverInterface>> _solvers
+	);
 
 	void reset() override;
+	/// Resets the portfolio and replaces the solvers linked into this binary by new ones, so
+	/// that the answers to the following queries do not depend on the earlier ones.
+	void renew();
 
 	void push() override;
 	void pop() override;
@@ -57,10 +83,37 @@ public:
 
 	std::vector<std::string> unhandledQueries() override;
 	unsigned solvers() override { return m_solvers.size(); }
+
+	/// Sets the cache that answered queries are looked up in and stored to.
+	void setQueryCache(std::shared_ptr<SMTQueryCache> _queryCache) { m_queryCache = std::move(_queryCache); }
+	/// Lets queries wait for the answers of all solvers, so that conflicting answers are reported.
+	void setWaitForAllSolvers(bool _wait = true) { m_waitForAllSolvers = _wait; }
 private:
+	/// Appends the solvers linked into this binary to m_solvers.
+	void addLinkedSolvers();
+	/// Queries the solvers one after the other and combines their results.
+	std::pair<CheckResult, std::vector<std::string>> checkAll(std::vector<smt::Expression> const& _expressionsToEvaluate);
+	/// Queries the solvers concurrently and interrupts the solvers that are still running once
+	/// the answer is decided.
+	std::pair<CheckResult, std::vector<std::string>> race(std::vector<smt::Expression> const& _expressionsToEvaluate);
+
 	static bool solverAnswered(CheckResult result);
 
+	/// @returns the key of the query in the query cache. It includes the versions of the compiler
+	/// and of the solvers and the timeout since they influence the answer. The version of a solver
+	/// process is the one it reports, so it is started if it is not running.
+	h256 queryCacheKey(std::vector<smt::Expression> const& _expressionsToEvaluate);
+
 	std::vector<std::unique_ptr<smt::SolverInterface>> m_solvers;
+	/// The SMT-LIB2 solver of m_solvers, used to serialise queries for the cache.
+	SMTLib2Interface* m_smtlib2 = nullptr;
+	std::string m_solverCommand;
+	/// False if the solvers were given to the constructor instead of the linked ones.
+	bool m_linkedSolvers = true;
+	bool m_waitForAllSolvers = false;
+	std::shared_ptr<SMTQueryCache> m_queryCache;
+	/// Runs the solvers of a race, created by the first race.
+	std::unique_ptr<ThreadPool> m_threadPool;
 
 	std::vector<smt::Expression> m_assertions;
 };
@@ -0,0 +1,128 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Cache of the results of SMT queries.
+ */
+
+#include <libsolidity/formal/SMTQueryCache.h>
+
+#include <libdevcore/CommonIO.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity::smt;
+
+namespace
+{
+
+string const c_magic = "solc-smt-cache 1";
+
+}
+
+boost::optional<SMTQueryCache::Result> SMTQueryCache::lookup(h256 const& _key)
+{
+	{
+		shared_lock<shared_timed_mutex> lock(m_mutex);
+		auto it = m_entries.find(_key);
+		if (it != m_entries.end())
+		{
+			m_hits++;
+			return it->second;
+		}
+	}
+
+	boost::optional<Result> result;
+	if (!m_directory.empty())
+		result = load(_key);
+	if (!result)
+	{
+		m_misses++;
+		return {};
+	}
+	m_hits++;
+	unique_lock<shared_timed_mutex> lock(m_mutex);
+	m_entries.emplace(_key, *result);
+	return result;
+}
+
+void SMTQueryCache::store(h256 const& _key, Result const& _result)
+{
+	if (_result.first != CheckResult::SATISFIABLE && _result.first != CheckResult::UNSATISFIABLE)
+		return;
+	{
+		unique_lock<shared_timed_mutex> lock(m_mutex);
+		if (!m_entries.emplace(_key, _result).second)
+			return;
+	}
+	if (!m_directory.empty())
+		save(_key, _result);
+}
+
+// An entry consists of a line with the magic string, a line with the result and for every
+// value a line with its length followed by the value itself.
+boost::optional<SMTQueryCache::Result> SMTQueryCache::load(h256 const& _key) const
+{
+	string const path = (boost::filesystem::path(m_directory) / _key.hex()).string();
+	ifstream file(path, ios::binary);
+	if (!file)
+		return {};
+	string content{istreambuf_iterator<char>(file), istreambuf_iterator<char>()};
+	istringstream input(content);
+
+	string magic;
+	string result;
+	if (!getline(input, magic) || magic != c_magic || !getline(input, result))
+		return {};
+	Result entry;
+	if (result == "sat")
+		entry.first = CheckResult::SATISFIABLE;
+	else if (result == "unsat")
+		entry.first = CheckResult::UNSATISFIABLE;
+	else
+		return {};
+	for (size_t length; input >> length;)
+	{
+		if (input.get() != '\n' || length > content.size())
+			return {};
+		string value(length, '\0');
+		if (!input.read(&value[0], streamsize(length)))
+			return {};
+		entry.second.emplace_back(move(value));
+	}
+	if (!input.eof())
+		return {};
+	return entry;
+}
+
+void SMTQueryCache::save(h256 const& _key, Result const& _result) const
+{
+	ostringstream output;
+	output << c_magic << "\n" << (_result.first == CheckResult::SATISFIABLE ? "sat" : "unsat") << "\n";
+	for (string const& value: _result.second)
+		output << value.size() << "\n" << value;
+
+	// Entries that cannot be loaded, e.g. because they were truncated, are replaced.
+	if (!load(_key))
+		writeFileAtomically((boost::filesystem::path(m_directory) / _key.hex()).string(), output.str());
+}
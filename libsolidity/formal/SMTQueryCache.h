@@ -0,0 +1,83 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Cache of the results of SMT queries.
+ */
+
+#pragma once
+
+#include <libsolidity/formal/SolverInterface.h>
+
+#include <libdevcore/FixedHash.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+
+#include <atomic>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+namespace smt
+{
+
+/**
+ * Cache of answered SMT queries that can be shared by concurrent compilations.
+ * Only SATISFIABLE and UNSATISFIABLE results are stored, together with the values of the
+ * expressions that were requested with the query. Since the key is a hash, the caller has to
+ * include everything that influences the result in it.
+ *
+ * Entries are kept in memory and, if a directory is given, also stored on disk with one file
+ * per entry, so that they can be reused by later compiler runs. Files are written to a
+ * temporary file first and then renamed, so a directory can be shared by concurrent runs.
+ */
+class SMTQueryCache: boost::noncopyable
+{
+public:
+	using Result = std::pair<CheckResult, std::vector<std::string>>;
+
+	explicit SMTQueryCache(std::string _directory = std::string()): m_directory(std::move(_directory)) {}
+
+	/// @returns the result stored for @a _key or an empty optional if there is none.
+	boost::optional<Result> lookup(h256 const& _key);
+	/// Stores @a _result for @a _key if it is an answer. Errors writing to disk are ignored.
+	void store(h256 const& _key, Result const& _result);
+
+	size_t hits() const { return m_hits; }
+	size_t misses() const { return m_misses; }
+
+private:
+	boost::optional<Result> load(h256 const& _key) const;
+	void save(h256 const& _key, Result const& _result) const;
+
+	std::string const m_directory;
+	/// Guards m_entries. Lookups only need shared access.
+	std::shared_timed_mutex m_mutex;
+	std::map<h256, Result> m_entries;
+	std::atomic<size_t> m_hits{0};
+	std::atomic<size_t> m_misses{0};
+};
+
+}
+}
+}
@@ -0,0 +1,152 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <libsolidity/formal/SolverInterface.h>
+
+#include <boost/functional/hash.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity::smt;
+
+namespace
+{
+
+Operator operatorFromName(string const& _name)
+{
+	static map<string, Operator> const operators{
+		{"ite", Operator::Ite},
+		{"not", Operator::Not},
+		{"and", Operator::And},
+		{"or", Operator::Or},
+		{"implies", Operator::Implies},
+		{"=", Operator::Equal},
+		{"<", Operator::Less},
+		{"<=", Operator::LessOrEqual},
+		{">", Operator::Greater},
+		{">=", Operator::GreaterOrEqual},
+		{"+", Operator::Add},
+		{"-", Operator::Sub},
+		{"*", Operator::Mul},
+		{"/", Operator::Div},
+		{"mod", Operator::Mod},
+		{"select", Operator::Select},
+		{"store", Operator::Store},
+		{"const_array", Operator::ConstArray}
+	};
+	auto it = operators.find(_name);
+	return it == operators.end() ? Operator::None : it->second;
+}
+
+unsigned arity(Operator _op)
+{
+	switch (_op)
+	{
+	case Operator::None:
+		return 0;
+	case Operator::Not:
+		return 1;
+	case Operator::Ite:
+	case Operator::Store:
+		return 3;
+	default:
+		return 2;
+	}
+}
+
+bool equalSorts(SortPointer const& _a, SortPointer const& _b)
+{
+	if (_a == _b)
+		return true;
+	return _a && _b && *_a == *_b;
+}
+
+/// Table of the nodes created by the current thread. Nodes are owned by the expressions
+/// referring to them, so the table only keeps weak references and drops expired ones
+/// whenever it grew to twice the size it had after the last sweep.
+template <class Node>
+struct NodeTable
+{
+	void sweep()
+	{
+		for (auto it = nodes.begin(); it != nodes.end();)
+			if (it->second.expired())
+				it = nodes.erase(it);
+			else
+				++it;
+		sweepThreshold = max<size_t>(1024, 2 * nodes.size());
+	}
+
+	unordered_multimap<size_t, weak_ptr<Node const>> nodes;
+	size_t sweepThreshold = 1024;
+};
+
+}
+
+Expression::Expression(string _name, vector<Expression> _arguments, SortPointer _sort)
+{
+	size_t hash = std::hash<string>{}(_name);
+	for (Expression const& argument: _arguments)
+		boost::hash_combine(hash, argument.hash());
+	if (_sort)
+		boost::hash_combine(hash, static_cast<int>(_sort->kind));
+
+	thread_local NodeTable<Node> table;
+	auto range = table.nodes.equal_range(hash);
+	for (auto it = range.first; it != range.second; ++it)
+		if (shared_ptr<Node const> node = it->second.lock())
+			if (
+				node->name == _name &&
+				equalSorts(node->sort, _sort) &&
+				node->arguments.size() == _arguments.size() &&
+				equal(
+					_arguments.begin(),
+					_arguments.end(),
+					node->arguments.begin(),
+					[](Expression const& _a, Expression const& _b) { return _a.identical(_b); }
+				)
+			)
+			{
+				m_node = move(node);
+				return;
+			}
+
+	Operator op = operatorFromName(_name);
+	m_node = make_shared<Node const>(Node{move(_name), move(_arguments), move(_sort), op, hash});
+	if (table.nodes.size() >= table.sweepThreshold)
+		table.sweep();
+	table.nodes.emplace(hash, m_node);
+}
+
+bool Expression::hasCorrectArity() const
+{
+	return op() != Operator::None && arity(op()) == arguments().size();
+}
+
+bool Expression::Node::equals(Node const& _other) const
+{
+	return
+		name == _other.name &&
+		equalSorts(sort, _other.sort) &&
+		arguments.size() == _other.arguments.size() &&
+		equal(
+			arguments.begin(),
+			arguments.end(),
+			_other.arguments.begin(),
+			[](Expression const& _a, Expression const& _b) { return _a.identical(_b); }
+		);
+}
@@ -26,7 +26,9 @@
 #include <boost/noncopyable.hpp>
 #include <cstdio>
 #include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace dev
@@ -132,7 +134,34 @@ struct SortSort: public Sort
 // Forward declaration.
 SortPointer smtSort(solidity::Type const& _type);
 
+/// Built-in operators of SMTLIB2 expressions.
+enum class Operator: uint8_t
+{
+	None,
+	Ite,
+	Not,
+	And,
+	Or,
+	Implies,
+	Equal,
+	Less,
+	LessOrEqual,
+	Greater,
+	GreaterOrEqual,
+	Add,
+	Sub,
+	Mul,
+	Div,
+	Mod,
+	Select,
+	Store,
+	ConstArray
+};
+
 /// C++ representation of an SMTLIB2 expression.
+/// Expressions are immutable and hash-consed: all structurally equal expressions that were
+/// created in the same thread share a single node. Copies are cheap, shared subexpressions
+/// are only stored once and comparing expressions of the same thread takes constant time.
 class Expression
 {
 	friend class SolverInterface;
@@ -149,35 +178,27 @@ public:
 	Expression& operator=(Expression const&) = default;
 	Expression& operator=(Expression&&) = default;
 
-	bool hasCorrectArity() const
+	std::string const& name() const { return m_node->name; }
+	std::vector<Expression> const& arguments() const { return m_node->arguments; }
+	SortPointer const& sort() const { return m_node->sort; }
+	/// @returns the built-in operator named by the expression or Operator::None.
+	Operator op() const { return m_node->op; }
+	/// @returns a hash of the structure of the expression.
+	size_t hash() const { return m_node->hash; }
+
+	/// @returns true if both expressions are structurally equal. This does not construct
+	/// an SMT equality, which is done by operator==.
+	bool identical(Expression const& _other) const
 	{
-		static std::map<std::string, unsigned> const operatorsArity{
-			{"ite", 3},
-			{"not", 1},
-			{"and", 2},
-			{"or", 2},
-			{"implies", 2},
-			{"=", 2},
-			{"<", 2},
-			{"<=", 2},
-			{">", 2},
-			{">=", 2},
-			{"+", 2},
-			{"-", 2},
-			{"*", 2},
-			{"/", 2},
-			{"mod", 2},
-			{"select", 2},
-			{"store", 3},
-			{"const_array", 2}
-		};
-		return operatorsArity.count(name) && operatorsArity.at(name) == arguments.size();
+		return m_node == _other.m_node || (m_node->hash == _other.m_node->hash && m_node->equals(*_other.m_node));
 	}
 
+	bool hasCorrectArity() const;
+
 	static Expression ite(Expression _condition, Expression _trueValue, Expression _falseValue)
 	{
-		solAssert(*_trueValue.sort == *_falseValue.sort, "");
-		SortPointer sort = _trueValue.sort;
+		solAssert(*_trueValue.sort() == *_falseValue.sort(), "");
+		SortPointer sort = _trueValue.sort();
 		return Expression("ite", std::vector<Expression>{
 			std::move(_condition), std::move(_trueValue), std::move(_falseValue)
 		}, std::move(sort));
@@ -196,11 +217,11 @@ public:
 	/// select is the SMT representation of an array index access.
 	static Expression select(Expression _array, Expression _index)
 	{
-		solAssert(_array.sort->kind == Kind::Array, "");
-		std::shared_ptr<ArraySort> arraySort = std::dynamic_pointer_cast<ArraySort>(_array.sort);
+		solAssert(_array.sort()->kind == Kind::Array, "");
+		std::shared_ptr<ArraySort> arraySort = std::dynamic_pointer_cast<ArraySort>(_array.sort());
 		solAssert(arraySort, "");
-		solAssert(_index.sort, "");
-		solAssert(*arraySort->domain == *_index.sort, "");
+		solAssert(_index.sort(), "");
+		solAssert(*arraySort->domain == *_index.sort(), "");
 		return Expression(
 			"select",
 			std::vector<Expression>{std::move(_array), std::move(_index)},
@@ -212,13 +233,13 @@ public:
 	/// The function is pure and returns the modified array.
 	static Expression store(Expression _array, Expression _index, Expression _element)
 	{
-		solAssert(_array.sort->kind == Kind::Array, "");
-		std::shared_ptr<ArraySort> arraySort = std::dynamic_pointer_cast<ArraySort>(_array.sort);
+		solAssert(_array.sort()->kind == Kind::Array, "");
+		std::shared_ptr<ArraySort> arraySort = std::dynamic_pointer_cast<ArraySort>(_array.sort());
 		solAssert(arraySort, "");
-		solAssert(_index.sort, "");
-		solAssert(_element.sort, "");
-		solAssert(*arraySort->domain == *_index.sort, "");
-		solAssert(*arraySort->range == *_element.sort, "");
+		solAssert(_index.sort(), "");
+		solAssert(_element.sort(), "");
+		solAssert(*arraySort->domain == *_index.sort(), "");
+		solAssert(*arraySort->range == *_element.sort(), "");
 		return Expression(
 			"store",
 			std::vector<Expression>{std::move(_array), std::move(_index), std::move(_element)},
@@ -228,12 +249,12 @@ public:
 
 	static Expression const_array(Expression _sort, Expression _value)
 	{
-		solAssert(_sort.sort->kind == Kind::Sort, "");
-		auto sortSort = std::dynamic_pointer_cast<SortSort>(_sort.sort);
+		solAssert(_sort.sort()->kind == Kind::Sort, "");
+		auto sortSort = std::dynamic_pointer_cast<SortSort>(_sort.sort());
 		auto arraySort = std::dynamic_pointer_cast<ArraySort>(sortSort->inner);
 		solAssert(sortSort && arraySort, "");
-		solAssert(_value.sort, "");
-		solAssert(*arraySort->range == *_value.sort, "");
+		solAssert(_value.sort(), "");
+		solAssert(*arraySort->range == *_value.sort(), "");
 		return Expression(
 			"const_array",
 			std::vector<Expression>{std::move(_sort), std::move(_value)},
@@ -300,22 +321,28 @@ public:
 	Expression operator()(std::vector<Expression> _arguments) const
 	{
 		solAssert(
-			sort->kind == Kind::Function,
+			sort()->kind == Kind::Function,
 			"Attempted function application to non-function."
 		);
-		auto fSort = dynamic_cast<FunctionSort const*>(sort.get());
+		auto fSort = dynamic_cast<FunctionSort const*>(sort().get());
 		solAssert(fSort, "");
-		return Expression(name, std::move(_arguments), fSort->codomain);
+		return Expression(name(), std::move(_arguments), fSort->codomain);
 	}
 
-	std::string name;
-	std::vector<Expression> arguments;
-	SortPointer sort;
-
 private:
+	struct Node
+	{
+		bool equals(Node const& _other) const;
+
+		std::string name;
+		std::vector<Expression> arguments;
+		SortPointer sort;
+		Operator op;
+		size_t hash;
+	};
+
 	/// Manual constructors, should only be used by SolverInterface and this class itself.
-	Expression(std::string _name, std::vector<Expression> _arguments, SortPointer _sort):
-		name(std::move(_name)), arguments(std::move(_arguments)), sort(std::move(_sort)) {}
+	Expression(std::string _name, std::vector<Expression> _arguments, SortPointer _sort);
 	Expression(std::string _name, std::vector<Expression> _arguments, Kind _kind):
 		Expression(std::move(_name), std::move(_arguments), std::make_shared<Sort>(_kind)) {}
 
@@ -325,8 +352,24 @@ private:
 		Expression(std::move(_name), std::vector<Expression>{std::move(_arg)}, _kind) {}
 	Expression(std::string _name, Expression _arg1, Expression _arg2, Kind _kind):
 		Expression(std::move(_name), std::vector<Expression>{std::move(_arg1), std::move(_arg2)}, _kind) {}
+
+	std::shared_ptr<Node const> m_node;
+};
+
+/// Hash and equality of expressions for unordered containers.
+struct ExpressionHash
+{
+	size_t operator()(Expression const& _expr) const { return _expr.hash(); }
+};
+struct ExpressionIdentical
+{
+	bool operator()(Expression const& _a, Expression const& _b) const { return _a.identical(_b); }
 };
 
+/// Map from expressions, used for example to memoise translations of shared subexpressions.
+template <class T>
+using ExpressionMap = std::unordered_map<Expression, T, ExpressionHash, ExpressionIdentical>;
+
 DEV_SIMPLE_EXCEPTION(SolverError);
 
 class SolverInterface
@@ -354,6 +397,10 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Asks a running call to @a check to return as soon as possible, usually with UNKNOWN.
+	/// Can be called from another thread. Does nothing if the solver does not support it.
+	virtual void interrupt() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
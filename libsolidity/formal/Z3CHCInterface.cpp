@@ -54,7 +54,7 @@ void Z3CHCInterface::declareVariable(string const& _name, Sort const& _sort)
 
 void Z3CHCInterface::registerRelation(Expression const& _expr)
 {
-	m_solver.register_relation(m_z3Interface->functions().at(_expr.name));
+	m_solver.register_relation(m_z3Interface->functions().at(_expr.name()));
 }
 
 void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
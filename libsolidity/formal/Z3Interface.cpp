@@ -35,6 +35,7 @@ Z3Interface::Z3Interface():
 
 void Z3Interface::reset()
 {
+	m_translations.clear();
 	m_constants.clear();
 	m_functions.clear();
 	m_solver.reset();
@@ -108,17 +109,42 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 	return make_pair(result, values);
 }
 
+void Z3Interface::interrupt()
+{
+	m_context.interrupt();
+}
+
+string Z3Interface::version()
+{
+	unsigned major;
+	unsigned minor;
+	unsigned build;
+	unsigned revision;
+	Z3_get_version(&major, &minor, &build, &revision);
+	return to_string(major) + "." + to_string(minor) + "." + to_string(build) + "." + to_string(revision);
+}
+
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 {
-	if (_expr.arguments.empty() && m_constants.count(_expr.name))
-		return m_constants.at(_expr.name);
+	auto it = m_translations.find(_expr);
+	if (it != m_translations.end())
+		return it->second;
+	z3::expr result = translate(_expr);
+	m_translations.emplace(_expr, result);
+	return result;
+}
+
+z3::expr Z3Interface::translate(Expression const& _expr)
+{
+	if (_expr.arguments().empty() && m_constants.count(_expr.name()))
+		return m_constants.at(_expr.name());
 	z3::expr_vector arguments(m_context);
-	for (auto const& arg: _expr.arguments)
+	for (auto const& arg: _expr.arguments())
 		arguments.push_back(toZ3Expr(arg));
 
 	try
 	{
-		string const& n = _expr.name;
+		string const& n = _expr.name();
 		if (m_functions.count(n))
 			return m_functions.at(n)(arguments);
 		else if (m_constants.count(n))
@@ -132,9 +158,9 @@ z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 				return m_context.bool_val(true);
 			else if (n == "false")
 				return m_context.bool_val(false);
-			else if (_expr.sort->kind == Kind::Sort)
+			else if (_expr.sort()->kind == Kind::Sort)
 			{
-				auto sortSort = dynamic_pointer_cast<SortSort>(_expr.sort);
+				auto sortSort = dynamic_pointer_cast<SortSort>(_expr.sort());
 				solAssert(sortSort, "");
 				return m_context.constant(n.c_str(), z3Sort(*sortSort->inner));
 			}
@@ -150,48 +176,53 @@ z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 		}
 
 		solAssert(_expr.hasCorrectArity(), "");
-		if (n == "ite")
+		switch (_expr.op())
+		{
+		case Operator::Ite:
 			return z3::ite(arguments[0], arguments[1], arguments[2]);
-		else if (n == "not")
+		case Operator::Not:
 			return !arguments[0];
-		else if (n == "and")
+		case Operator::And:
 			return arguments[0] && arguments[1];
-		else if (n == "or")
+		case Operator::Or:
 			return arguments[0] || arguments[1];
-		else if (n == "implies")
+		case Operator::Implies:
 			return z3::implies(arguments[0], arguments[1]);
-		else if (n == "=")
+		case Operator::Equal:
 			return arguments[0] == arguments[1];
-		else if (n == "<")
+		case Operator::Less:
 			return arguments[0] < arguments[1];
-		else if (n == "<=")
+		case Operator::LessOrEqual:
 			return arguments[0] <= arguments[1];
-		else if (n == ">")
+		case Operator::Greater:
 			return arguments[0] > arguments[1];
-		else if (n == ">=")
+		case Operator::GreaterOrEqual:
 			return arguments[0] >= arguments[1];
-		else if (n == "+")
+		case Operator::Add:
 			return arguments[0] + arguments[1];
-		else if (n == "-")
+		case Operator::Sub:
 			return arguments[0] - arguments[1];
-		else if (n == "*")
+		case Operator::Mul:
 			return arguments[0] * arguments[1];
-		else if (n == "/")
+		case Operator::Div:
 			return arguments[0] / arguments[1];
-		else if (n == "mod")
+		case Operator::Mod:
 			return z3::mod(arguments[0], arguments[1]);
-		else if (n == "select")
+		case Operator::Select:
 			return z3::select(arguments[0], arguments[1]);
-		else if (n == "store")
+		case Operator::Store:
 			return z3::store(arguments[0], arguments[1], arguments[2]);
-		else if (n == "const_array")
+		case Operator::ConstArray:
 		{
-			shared_ptr<SortSort> sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments[0].sort);
+			shared_ptr<SortSort> sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments()[0].sort());
 			solAssert(sortSort, "");
 			auto arraySort = dynamic_pointer_cast<ArraySort>(sortSort->inner);
 			solAssert(arraySort && arraySort->domain, "");
 			return z3::const_array(z3Sort(*arraySort->domain), arguments[1]);
 		}
+		default:
+			break;
+		}
 
 		solAssert(false, "");
 	}
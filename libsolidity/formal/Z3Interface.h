@@ -42,6 +42,10 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
+
+	/// @returns the version of the linked Z3 library.
+	static std::string version();
 
 	z3::expr toZ3Expr(Expression const& _expr);
 
@@ -53,6 +57,9 @@ public:
 private:
 	void declareFunction(std::string const& _name, Sort const& _sort);
 
+	/// Translates @a _expr without looking it up in m_translations.
+	z3::expr translate(Expression const& _expr);
+
 	z3::sort z3Sort(smt::Sort const& _sort);
 	z3::sort_vector z3Sort(std::vector<smt::SortPointer> const& _sorts);
 
@@ -61,6 +68,9 @@ private:
 
 	z3::context m_context;
 	z3::solver m_solver;
+	/// Translations of the expressions seen since the last reset. Since expressions are shared,
+	/// this translates every subexpression only once.
+	ExpressionMap<z3::expr> m_translations;
 };
 
 }
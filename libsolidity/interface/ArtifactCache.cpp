@@ -0,0 +1,180 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * On-disk cache of the artifacts of compiled contracts.
+ */
+
+#include <libsolidity/interface/ArtifactCache.h>
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/Exceptions.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+namespace
+{
+
+string const c_magic = "solc-artifacts";
+char const c_formatVersion = 1;
+
+DEV_SIMPLE_EXCEPTION(InvalidCacheEntry);
+
+class EntryWriter
+{
+public:
+	void writeNumber(uint64_t _value)
+	{
+		for (unsigned i = 0; i < 8; ++i)
+			m_data.push_back(char(uint8_t(_value >> (8 * i))));
+	}
+	void writeString(string const& _value)
+	{
+		writeNumber(_value.size());
+		m_data += _value;
+	}
+	void writeObject(eth::LinkerObject const& _object)
+	{
+		writeString(string(_object.bytecode.begin(), _object.bytecode.end()));
+		writeNumber(_object.linkReferences.size());
+		for (auto const& reference: _object.linkReferences)
+		{
+			writeNumber(reference.first);
+			writeString(reference.second);
+		}
+	}
+
+	string const& data() const { return m_data; }
+
+private:
+	string m_data = c_magic + c_formatVersion;
+};
+
+class EntryReader
+{
+public:
+	EntryReader(char const* _data, size_t _size): m_data(_data), m_size(_size)
+	{
+		if (readBytes(c_magic.size() + 1) != c_magic + c_formatVersion)
+			BOOST_THROW_EXCEPTION(InvalidCacheEntry());
+	}
+
+	uint64_t readNumber()
+	{
+		string bytes = readBytes(8);
+		uint64_t value = 0;
+		for (unsigned i = 0; i < 8; ++i)
+			value |= uint64_t(uint8_t(bytes[i])) << (8 * i);
+		return value;
+	}
+	string readString()
+	{
+		return readBytes(readNumber());
+	}
+	eth::LinkerObject readObject()
+	{
+		eth::LinkerObject object;
+		string bytecode = readString();
+		object.bytecode = bytes(bytecode.begin(), bytecode.end());
+		for (uint64_t references = readNumber(); references > 0; --references)
+		{
+			size_t offset = readNumber();
+			object.linkReferences[offset] = readString();
+		}
+		return object;
+	}
+
+	bool atEnd() const { return m_position == m_size; }
+
+private:
+	string readBytes(uint64_t _length)
+	{
+		if (_length > m_size - m_position)
+			BOOST_THROW_EXCEPTION(InvalidCacheEntry());
+		string result(m_data + m_position, m_data + m_position + _length);
+		m_position += _length;
+		return result;
+	}
+
+	char const* m_data;
+	size_t m_size;
+	size_t m_position = 0;
+};
+
+}
+
+boost::optional<ArtifactCache::Artifacts> ArtifactCache::load(h256 const& _key) const
+{
+	string const path = entryPath(_key);
+	try
+	{
+		if (!boost::filesystem::exists(path) || boost::filesystem::file_size(path) == 0)
+			return {};
+
+		boost::interprocess::file_mapping file(path.c_str(), boost::interprocess::read_only);
+		boost::interprocess::mapped_region region(file, boost::interprocess::read_only);
+		EntryReader reader(static_cast<char const*>(region.get_address()), region.get_size());
+
+		Artifacts artifacts;
+		artifacts.object = reader.readObject();
+		artifacts.runtimeObject = reader.readObject();
+		artifacts.sourceMapping = reader.readString();
+		artifacts.runtimeSourceMapping = reader.readString();
+		artifacts.assembly = reader.readString();
+		artifacts.assemblyJSON = reader.readString();
+		if (!reader.atEnd())
+			return {};
+		return artifacts;
+	}
+	catch (InvalidCacheEntry const&)
+	{
+		return {};
+	}
+	catch (boost::interprocess::interprocess_exception const&)
+	{
+		return {};
+	}
+	catch (boost::filesystem::filesystem_error const&)
+	{
+		return {};
+	}
+}
+
+void ArtifactCache::store(h256 const& _key, Artifacts const& _artifacts) const
+{
+	EntryWriter writer;
+	writer.writeObject(_artifacts.object);
+	writer.writeObject(_artifacts.runtimeObject);
+	writer.writeString(_artifacts.sourceMapping);
+	writer.writeString(_artifacts.runtimeSourceMapping);
+	writer.writeString(_artifacts.assembly);
+	writer.writeString(_artifacts.assemblyJSON);
+
+	// Entries that cannot be loaded, e.g. because they were truncated, are replaced.
+	if (!load(_key))
+		writeFileAtomically(entryPath(_key), writer.data());
+}
+
+string ArtifactCache::entryPath(h256 const& _key) const
+{
+	return (boost::filesystem::path(m_directory) / _key.hex()).string();
+}
@@ -0,0 +1,76 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * On-disk cache of the artifacts of compiled contracts.
+ */
+
+#pragma once
+
+#include <libevmasm/LinkerObject.h>
+
+#include <libdevcore/FixedHash.h>
+
+#include <boost/optional.hpp>
+
+#include <string>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Content-addressed cache of compiled contracts in a directory. Every entry is a single file
+ * named after the hash of all inputs that influence the compilation of a contract. Entries are
+ * written to a temporary file first and then renamed, so that a directory can be shared by
+ * concurrent compiler runs.
+ *
+ * An entry consists of a magic string, a format version byte and the fields of @a Artifacts
+ * in declaration order. Strings are prefixed by their length and numbers are encoded as 64 bit
+ * little-endian integers, so that entries can be read directly from a memory-mapped file.
+ */
+class ArtifactCache
+{
+public:
+	struct Artifacts
+	{
+		eth::LinkerObject object;
+		eth::LinkerObject runtimeObject;
+		std::string sourceMapping;
+		std::string runtimeSourceMapping;
+		std::string assembly;
+		/// Compact JSON representation of the assembly.
+		std::string assemblyJSON;
+	};
+
+	explicit ArtifactCache(std::string _directory): m_directory(std::move(_directory)) {}
+
+	/// @returns the artifacts stored for @a _key or an empty optional if there is no valid entry.
+	boost::optional<Artifacts> load(h256 const& _key) const;
+
+	/// Stores @a _artifacts for @a _key unless a valid entry exists already. Errors are ignored
+	/// because the cache is only used to speed up compilation.
+	void store(h256 const& _key, Artifacts const& _artifacts) const;
+
+private:
+	std::string entryPath(h256 const& _key) const;
+
+	std::string m_directory;
+};
+
+}
+}
@@ -37,6 +37,7 @@
 #include <libsolidity/analysis/ViewPureChecker.h>
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
 #include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/formal/ModelChecker.h>
@@ -62,6 +63,7 @@
 #include <libevmasm/Exceptions.h>
 
 #include <libdevcore/SwarmHash.h>
+#include <libdevcore/ThreadPool.h>
 #include <libdevcore/IpfsHash.h>
 #include <libdevcore/JSON.h>
 
@@ -74,7 +76,41 @@ using namespace dev;
 using namespace langutil;
 using namespace dev::solidity;
 
-static int g_compilerStackCounts = 0;
+/// Number of CompilerStack instances in the current thread.
+static thread_local int g_compilerStackCounts = 0;
+
+namespace
+{
+
+/// Moves the IDs of all nodes of an AST from the range starting after @a _from
+/// to the range starting after @a _to.
+class IDShifter: private ASTVisitor
+{
+public:
+	IDShifter(size_t _from, size_t _to): m_from(_from), m_to(_to) {}
+
+	void shift(SourceUnit& _ast) { _ast.accept(*this); }
+
+private:
+	bool visit(ImportDirective& _import) override
+	{
+		// The identifiers of symbol aliases are not visited as child nodes.
+		for (auto const& alias: _import.symbolAliases())
+			shiftID(*alias.first);
+		return visitNode(_import);
+	}
+	bool visitNode(ASTNode& _node) override
+	{
+		shiftID(_node);
+		return true;
+	}
+	void shiftID(ASTNode& _node) { _node.setID(_node.id() - m_from + m_to); }
+
+	size_t m_from;
+	size_t m_to;
+};
+
+}
 
 CompilerStack::CompilerStack(ReadCallback::Callback const& _readFile):
 	m_readFile{_readFile},
@@ -83,9 +119,9 @@ CompilerStack::CompilerStack(ReadCallback::Callback const& _readFile):
 	m_errorList{},
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
-	// no more than one entity is actually using it at a time.
-	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
+	// Because TypeProvider is a singleton API per thread, we must ensure that
+	// no more than one entity in a thread is actually using it at a time.
+	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me in this thread.");
 	++g_compilerStackCounts;
 }
 
@@ -180,9 +216,12 @@ void CompilerStack::reset(bool _keepSettings)
 		m_evmVersion = langutil::EVMVersion();
 		m_generateIR = false;
 		m_generateEWasm = false;
+		m_parallelism = 1;
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
 	}
+	m_previousSources.clear();
+	m_replacedASTs.clear();
 	m_globalContext.reset();
 	m_scopes.clear();
 	m_sourceOrder.clear();
@@ -202,6 +241,40 @@ void CompilerStack::setSources(StringMap _sources)
 	m_stackState = SourcesSet;
 }
 
+void CompilerStack::updateSources(StringMap _sources)
+{
+	// The analysis of a source can only be re-used if it was successful. Furthermore,
+	// replaced ASTs are only kept until they outnumber the sources in use.
+	bool const reuseAnalysis =
+		m_stackState >= AnalysisPerformed &&
+		!m_hasError &&
+		m_replacedASTs.size() <= m_sources.size();
+	if (!reuseAnalysis)
+	{
+		map<h256, string> smtlib2Responses = std::move(m_smtlib2Responses);
+		reset(true);
+		m_smtlib2Responses = std::move(smtlib2Responses);
+		setSources(std::move(_sources));
+		return;
+	}
+
+	set<Source const*> analysedSources(m_sourceOrder.begin(), m_sourceOrder.end());
+	m_previousSources.clear();
+	for (auto& source: m_sources)
+		if (analysedSources.count(&source.second))
+			m_previousSources[source.first] = std::move(source.second);
+		else if (source.second.ast)
+			m_replacedASTs.push_back(source.second.ast);
+	m_sources.clear();
+	m_sourceOrder.clear();
+	m_scopes.clear();
+	m_contracts.clear();
+	m_unhandledSMTLib2Queries.clear();
+	m_errorReporter.clear();
+	m_stackState = Empty;
+	setSources(std::move(_sources));
+}
+
 bool CompilerStack::parse()
 {
 	if (m_stackState != SourcesSet)
@@ -218,36 +291,137 @@ bool CompilerStack::parse()
 			"Do not use it in production unless correctness of generated code is verified with extensive tests."
 		);
 
+	ErrorList const globalErrors = m_errorReporter.errors();
+	bool reparsed = false;
+
 	vector<string> sourcesToParse;
 	for (auto const& s: m_sources)
 		sourcesToParse.push_back(s.first);
+	auto addSources = [&](StringMap const& _newSources)
+	{
+		for (auto const& newSource: _newSources)
+		{
+			string const& newPath = newSource.first;
+			string const& newContents = newSource.second;
+			m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
+			sourcesToParse.push_back(newPath);
+		}
+	};
+	auto importsReused = [&](Source const& _source)
+	{
+		for (ASTPointer<ASTNode> const& node: _source.ast->nodes())
+			if (ImportDirective const* import = dynamic_cast<ImportDirective*>(node.get()))
+			{
+				auto imported = m_sources.find(import->annotation().absolutePath);
+				if (imported == m_sources.end() || !imported->second.reused)
+					return false;
+			}
+		return true;
+	};
+
 	for (size_t i = 0; i < sourcesToParse.size(); ++i)
 	{
 		string const& path = sourcesToParse[i];
 		Source& source = m_sources[path];
-		source.scanner->reset();
-		source.ast = Parser(m_errorReporter, m_evmVersion, m_parserErrorRecovery).parse(source.scanner);
-		if (!source.ast)
-			solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
+		auto previous = m_previousSources.find(path);
+		if (previous != m_previousSources.end() && previous->second.keccak256() == source.keccak256())
+		{
+			reuseSource(source, std::move(previous->second));
+			m_previousSources.erase(previous);
+			size_t const errorCount = m_errorReporter.errors().size();
+			addSources(loadMissingSources(*source.ast, path));
+			source.errors[Parsing] += ErrorList(m_errorReporter.errors().begin() + errorCount, m_errorReporter.errors().end());
+		}
 		else
+			addSources(parseSource(source, path));
+
+		if (i + 1 == sourcesToParse.size())
 		{
-			source.ast->annotation().path = path;
-			for (auto const& newSource: loadMissingSources(*source.ast, path))
+			// A source can only be re-used if all sources it imports are re-used as well.
+			// Otherwise it is parsed again, which assigns the same IDs because its content
+			// did not change.
+			size_t const lastID = ASTNode::lastID();
+			for (bool changed = true; changed;)
 			{
-				string const& newPath = newSource.first;
-				string const& newContents = newSource.second;
-				m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
-				sourcesToParse.push_back(newPath);
+				changed = false;
+				for (auto& reusedSource: m_sources)
+					if (reusedSource.second.reused && !importsReused(reusedSource.second))
+					{
+						m_replacedASTs.push_back(reusedSource.second.ast);
+						ASTNode::resetID(reusedSource.second.idOffset);
+						addSources(parseSource(reusedSource.second, reusedSource.first));
+						changed = reparsed = true;
+					}
 			}
+			ASTNode::resetID(lastID);
 		}
 	}
 
+	for (auto const& previousSource: m_previousSources)
+		m_replacedASTs.push_back(previousSource.second.ast);
+	m_previousSources.clear();
+
+	if (reparsed)
+	{
+		// Report the errors in the order of parsing.
+		m_errorReporter.clear();
+		m_errorReporter.append(globalErrors);
+		for (string const& path: sourcesToParse)
+			m_errorReporter.append(m_sources[path].errors[Parsing]);
+	}
+
 	m_stackState = ParsingPerformed;
 	if (!Error::containsOnlyWarnings(m_errorReporter.errors()))
 		m_hasError = true;
 	return !m_hasError;
 }
 
+void CompilerStack::reuseSource(Source& _source, Source&& _previous)
+{
+	size_t const idOffset = ASTNode::lastID();
+	IDShifter(_previous.idOffset, idOffset).shift(*_previous.ast);
+	_previous.lastID = _previous.lastID - _previous.idOffset + idOffset;
+	_previous.idOffset = idOffset;
+	_previous.reused = true;
+	_source = std::move(_previous);
+	ASTNode::resetID(_source.lastID);
+	m_errorReporter.append(_source.errors[Parsing]);
+}
+
+StringMap CompilerStack::parseSource(Source& _source, string const& _path)
+{
+	size_t const errorCount = m_errorReporter.errors().size();
+	StringMap newSources;
+	_source.reused = false;
+	_source.idOffset = ASTNode::lastID();
+	_source.scanner->reset();
+	_source.ast = Parser(m_errorReporter, m_evmVersion, m_parserErrorRecovery).parse(_source.scanner);
+	_source.lastID = ASTNode::lastID();
+	if (!_source.ast)
+		solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
+	else
+	{
+		_source.ast->annotation().path = _path;
+		newSources = loadMissingSources(*_source.ast, _path);
+	}
+	_source.errors.assign(AnalysisStepCount, ErrorList{});
+	_source.errors[Parsing] = ErrorList(m_errorReporter.errors().begin() + errorCount, m_errorReporter.errors().end());
+	return newSources;
+}
+
+bool CompilerStack::analyzeSource(Source& _source, AnalysisStep _step, function<bool()> const& _analyze)
+{
+	if (_source.reused)
+	{
+		m_errorReporter.append(_source.errors[_step]);
+		return true;
+	}
+	size_t const errorCount = m_errorReporter.errors().size();
+	bool const success = _analyze();
+	_source.errors[_step] = ErrorList(m_errorReporter.errors().begin() + errorCount, m_errorReporter.errors().end());
+	return success;
+}
+
 bool CompilerStack::analyze()
 {
 	if (m_stackState != ParsingPerformed || m_stackState >= AnalysisPerformed)
@@ -256,24 +430,51 @@ bool CompilerStack::analyze()
 
 	bool noErrors = true;
 
+	// Sources whose analysis is re-used are skipped by all steps except for the ones that
+	// register declarations and analyse all sources together.
+	bool const reuseAnalysis = any_of(m_sourceOrder.begin(), m_sourceOrder.end(), [](Source const* _source) {
+		return _source->reused;
+	});
+	auto forEachContract = [](Source const& _source, function<bool(ContractDefinition&)> const& _check)
+	{
+		bool success = true;
+		for (ASTPointer<ASTNode> const& node: _source.ast->nodes())
+			if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+				if (!_check(*contract))
+					success = false;
+		return success;
+	};
+
 	try
 	{
 		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
-		for (Source const* source: m_sourceOrder)
-			if (!syntaxChecker.checkSyntax(*source->ast))
+		for (Source* source: m_sourceOrder)
+			if (!analyzeSource(*source, SyntaxChecking, [&]() { return syntaxChecker.checkSyntax(*source->ast); }))
 				noErrors = false;
 
 		DocStringAnalyser docStringAnalyser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (!docStringAnalyser.analyseDocStrings(*source->ast))
+		for (Source* source: m_sourceOrder)
+			if (!analyzeSource(*source, DocStringAnalysis, [&]() { return docStringAnalyser.analyseDocStrings(*source->ast); }))
 				noErrors = false;
 
-		m_globalContext = make_shared<GlobalContext>();
+		// The global context of a previous run is kept because the analysis of re-used sources
+		// refers to its declarations.
+		if (!reuseAnalysis || !m_globalContext)
+			m_globalContext = make_shared<GlobalContext>();
+		size_t const lastParsedID = ASTNode::lastID();
 		NameAndTypeResolver resolver(*m_globalContext, m_scopes, m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (!resolver.registerDeclarations(*source->ast))
 				return false;
 
+		vector<ContractDefinition const*> contracts;
+		for (Source const* source: m_sourceOrder)
+			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+					contracts.push_back(contract);
+		if (reuseAnalysis)
+			ASTNode::resetID(m_globalContext->renumberDeclarations(lastParsedID, contracts));
+
 		map<string, SourceUnit const*> sourceUnitsByName;
 		for (auto& source: m_sources)
 			sourceUnitsByName[source.first] = source.second.ast.get();
@@ -283,30 +484,34 @@ bool CompilerStack::analyze()
 
 		// This is the main name and type resolution loop. Needs to be run for every contract, because
 		// the special variables "this" and "super" must be set appropriately.
-		for (Source const* source: m_sourceOrder)
-			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-				{
+		for (Source* source: m_sourceOrder)
+			if (!analyzeSource(*source, NameAndTypeResolution, [&]() {
+				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+						if (!resolver.resolveNamesAndTypes(*contract))
+							return false;
+				return true;
+			}))
+				return false;
 
-					if (!resolver.resolveNamesAndTypes(*contract)) return false;
-					// Note that we now reference contracts by their fully qualified names, and
-					// thus contracts can only conflict if declared in the same source file.  This
-					// already causes a double-declaration error elsewhere, so we do not report
-					// an error here and instead silently drop any additional contracts we find.
-					if (m_contracts.find(contract->fullyQualifiedName()) == m_contracts.end())
-						m_contracts[contract->fullyQualifiedName()].contract = contract;
-				}
+		// Note that we now reference contracts by their fully qualified names, and
+		// thus contracts can only conflict if declared in the same source file.  This
+		// already causes a double-declaration error elsewhere, so we do not report
+		// an error here and instead silently drop any additional contracts we find.
+		for (ContractDefinition const* contract: contracts)
+			if (m_contracts.find(contract->fullyQualifiedName()) == m_contracts.end())
+				m_contracts[contract->fullyQualifiedName()].contract = contract;
 
 		// Next, we check inheritance, overrides, function collisions and other things at
 		// contract or function level.
 		// This also calculates whether a contract is abstract, which is needed by the
 		// type checker.
 		ContractLevelChecker contractLevelChecker(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-					if (!contractLevelChecker.check(*contract))
-						noErrors = false;
+		for (Source* source: m_sourceOrder)
+			if (!analyzeSource(*source, ContractLevelChecking, [&]() {
+				return forEachContract(*source, [&](ContractDefinition& _contract) { return contractLevelChecker.check(_contract); });
+			}))
+				noErrors = false;
 
 		// New we run full type checks that go down to the expression level. This
 		// cannot be done earlier, because we need cross-contract types and information
@@ -316,18 +521,18 @@ bool CompilerStack::analyze()
 		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 		// which is only done one step later.
 		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-					if (!typeChecker.checkTypeRequirements(*contract))
-						noErrors = false;
+		for (Source* source: m_sourceOrder)
+			if (!analyzeSource(*source, TypeChecking, [&]() {
+				return forEachContract(*source, [&](ContractDefinition& _contract) { return typeChecker.checkTypeRequirements(_contract); });
+			}))
+				noErrors = false;
 
 		if (noErrors)
 		{
 			// Checks that can only be done when all types of all AST nodes are known.
 			PostTypeChecker postTypeChecker(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
-				if (!postTypeChecker.check(*source->ast))
+			for (Source* source: m_sourceOrder)
+				if (!analyzeSource(*source, PostTypeChecking, [&]() { return postTypeChecker.check(*source->ast); }))
 					noErrors = false;
 		}
 
@@ -336,15 +541,15 @@ bool CompilerStack::analyze()
 			// Control flow graph generator and analyzer. It can check for issues such as
 			// variable is used before it is assigned to.
 			CFG cfg(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
-				if (!cfg.constructFlow(*source->ast))
+			for (Source* source: m_sourceOrder)
+				if (!analyzeSource(*source, ControlFlowGraphConstruction, [&]() { return cfg.constructFlow(*source->ast); }))
 					noErrors = false;
 
 			if (noErrors)
 			{
 				ControlFlowAnalyzer controlFlowAnalyzer(cfg, m_errorReporter);
-				for (Source const* source: m_sourceOrder)
-					if (!controlFlowAnalyzer.analyze(*source->ast))
+				for (Source* source: m_sourceOrder)
+					if (!analyzeSource(*source, ControlFlowAnalysis, [&]() { return controlFlowAnalyzer.analyze(*source->ast); }))
 						noErrors = false;
 			}
 		}
@@ -353,8 +558,8 @@ bool CompilerStack::analyze()
 		{
 			// Checks for common mistakes. Only generates warnings.
 			StaticAnalyzer staticAnalyzer(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
-				if (!staticAnalyzer.analyze(*source->ast))
+			for (Source* source: m_sourceOrder)
+				if (!analyzeSource(*source, StaticAnalysis, [&]() { return staticAnalyzer.analyze(*source->ast); }))
 					noErrors = false;
 		}
 
@@ -371,7 +576,9 @@ bool CompilerStack::analyze()
 
 		if (noErrors)
 		{
-			ModelChecker modelChecker(m_errorReporter, m_smtlib2Responses);
+			ModelChecker modelChecker(m_errorReporter, m_smtlib2Responses, m_smtQueryCache, m_smtSolverCommand);
+			modelChecker.setParallelism(m_parallelism);
+			modelChecker.setWaitForAllSolvers(m_smtWaitForAllSolvers);
 			for (Source const* source: m_sourceOrder)
 				modelChecker.analyze(*source->ast);
 			m_unhandledSMTLib2Queries += modelChecker.unhandledQueries();
@@ -434,23 +641,58 @@ bool CompilerStack::compile()
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Called compile with errors."));
 
 	// Only compile contracts individually which have been requested.
-	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	vector<ContractDefinition const*> requestedContracts;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
-				{
-					compileContract(*contract, otherCompilers);
-					if (m_generateIR || m_generateEWasm)
-						generateIR(*contract);
-					if (m_generateEWasm)
-						generateEWasm(*contract);
-				}
+					requestedContracts.push_back(contract);
+
+	// Cached contracts are still compiled if other contracts need their code.
+	vector<ContractDefinition const*> contractsToCompile;
+	for (ContractDefinition const* contract: requestedContracts)
+		if (m_artifactCacheDirectory.empty() || !loadCachedArtifacts(*contract))
+			contractsToCompile.push_back(contract);
+
+	m_yulFunctionCache = make_shared<YulFunctionCache>(m_evmVersion);
+	ScopeGuard yulFunctionCacheGuard([&]() { m_yulFunctionCache.reset(); });
+	if (m_parallelism > 1)
+		compileContractsInParallel(contractsToCompile);
+	else
+	{
+		map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+		for (ContractDefinition const* contract: contractsToCompile)
+			compileContract(*contract, otherCompilers);
+	}
+
+	for (ContractDefinition const* contract: requestedContracts)
+	{
+		if (m_generateIR || m_generateEWasm)
+			generateIR(*contract);
+		if (m_generateEWasm)
+			generateEWasm(*contract);
+	}
 	m_stackState = CompilationSuccessful;
+	// The objects are stored before linking.
+	if (!m_artifactCacheDirectory.empty())
+		storeArtifacts();
 	this->link();
 	return true;
 }
 
+void CompilerStack::resetCompilation()
+{
+	if (m_stackState < AnalysisPerformed)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not performed."));
+	for (auto& contract: m_contracts)
+	{
+		ContractDefinition const* definition = contract.second.contract;
+		contract.second = Contract{};
+		contract.second.contract = definition;
+	}
+	m_stackState = AnalysisPerformed;
+}
+
 void CompilerStack::link()
 {
 	solAssert(m_stackState >= CompilationSuccessful, "");
@@ -603,6 +845,9 @@ string CompilerStack::assemblyString(string const& _contractName, StringMap _sou
 	Contract const& currentContract = contract(_contractName);
 	if (currentContract.compiler)
 		return currentContract.compiler->assemblyString(_sourceCodes);
+	// The cached assembly was printed using all sources.
+	else if (currentContract.cachedArtifacts && _sourceCodes == sourceCodes())
+		return currentContract.cachedArtifacts->assembly;
 	else
 		return string();
 }
@@ -616,6 +861,13 @@ Json::Value CompilerStack::assemblyJSON(string const& _contractName, StringMap c
 	Contract const& currentContract = contract(_contractName);
 	if (currentContract.compiler)
 		return currentContract.compiler->assemblyJSON(_sourceCodes);
+	// The cached assembly was printed using all sources.
+	else if (currentContract.cachedArtifacts && _sourceCodes == sourceCodes())
+	{
+		Json::Value assembly;
+		solAssert(jsonParseStrict(currentContract.cachedArtifacts->assemblyJSON, assembly), "");
+		return assembly;
+	}
 	else
 		return Json::Value();
 }
@@ -901,10 +1153,10 @@ void CompilerStack::resolveImports()
 	solAssert(m_stackState == ParsingPerformed, "");
 
 	// topological sorting (depth first search) of the import graph, cutting potential cycles
-	vector<Source const*> sourceOrder;
+	vector<Source*> sourceOrder;
 	set<Source const*> sourcesSeen;
 
-	function<void(Source const*)> toposort = [&](Source const* _source)
+	function<void(Source*)> toposort = [&](Source* _source)
 	{
 		if (sourcesSeen.count(_source))
 			return;
@@ -922,7 +1174,7 @@ void CompilerStack::resolveImports()
 		sourceOrder.push_back(_source);
 	};
 
-	for (auto const& sourcePair: m_sources)
+	for (auto& sourcePair: m_sources)
 		if (isRequestedSource(sourcePair.first))
 			toposort(&sourcePair.second);
 
@@ -954,20 +1206,129 @@ void CompilerStack::compileContract(
 	for (auto const* dependency: _contract.annotation().contractDependencies)
 		compileContract(*dependency, _otherCompilers);
 
+	shared_ptr<Compiler> compiler = generateContractCode(_contract, _otherCompilers);
+	assembleContract(_contract);
+
+	_otherCompilers[&_contract] = compiler;
+}
+
+void CompilerStack::compileContractsInParallel(vector<ContractDefinition const*> const& _contracts)
+{
+	solAssert(m_stackState >= AnalysisPerformed, "");
+	if (m_hasError)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Called compile with errors."));
+
+	// Determine the contracts to compile in the order used by the serial compilation,
+	// i.e. every contract comes after the contracts it creates.
+	vector<ContractDefinition const*> order;
+	set<ContractDefinition const*> visited;
+	function<void(ContractDefinition const&)> collect = [&](ContractDefinition const& _contract)
+	{
+		if (!_contract.canBeDeployed() || !visited.insert(&_contract).second)
+			return;
+		for (auto const* dependency: _contract.annotation().contractDependencies)
+			collect(*dependency);
+		order.push_back(&_contract);
+	};
+	for (ContractDefinition const* contract: _contracts)
+		collect(*contract);
+	if (order.empty())
+		return;
+
+	map<ContractDefinition const*, size_t> indices;
+	for (size_t i = 0; i < order.size(); ++i)
+		indices[order[i]] = i;
+
+	// For every contract, the indices of all earlier contracts whose assemblies it (transitively)
+	// embeds. The contract has to wait for them to be finished.
+	vector<set<size_t>> embedded(order.size());
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		set<ContractDefinition const*> seen;
+		function<void(ContractDefinition const&)> addEmbedded = [&](ContractDefinition const& _contract)
+		{
+			for (auto const* dependency: _contract.annotation().contractDependencies)
+				if (seen.insert(dependency).second)
+				{
+					if (indices.count(dependency) && indices.at(dependency) < i)
+						embedded[i].insert(indices.at(dependency));
+					addEmbedded(*dependency);
+				}
+		};
+		addEmbedded(*order[i]);
+	}
+	// The optimiser modifies embedded assemblies in place, so contracts that embed the same
+	// assembly are compiled one after the other in the serial order. Otherwise, the code of a
+	// contract would depend on how often the others optimised the assembly before.
+	vector<set<size_t>> dependencies = embedded;
+	for (size_t i = 0; i < order.size(); ++i)
+		for (size_t j = 0; j < i; ++j)
+			if (any_of(embedded[j].begin(), embedded[j].end(), [&](size_t _k) { return embedded[i].count(_k); }))
+				dependencies[i].insert(j);
+
+	// Code generation accesses the types of this thread.
+	TypeProvider& typeProvider = TypeProvider::instance();
+	// Guards code generation, which uses state shared between all contracts, and @a otherCompilers.
+	mutex codegenMutex;
+	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	vector<shared_future<void>> results(order.size());
+	// The threads not needed for compiling contracts concurrently are used by the assembly optimiser.
+	unsigned optimiserParallelism = max(1u, m_parallelism / unsigned(min<size_t>(m_parallelism, order.size())));
+	{
+		ThreadPool pool(min<size_t>(m_parallelism, order.size()));
+		for (size_t i = 0; i < order.size(); ++i)
+			results[i] = pool.submit([&, i]()
+			{
+				// Tasks start in submission order, so all dependencies have been started already.
+				for (size_t dependency: dependencies[i])
+					shared_future<void>(results[dependency]).get();
+
+				shared_ptr<Compiler> compiler;
+				{
+					lock_guard<mutex> lock(codegenMutex);
+					TypeProvider::Scope typeProviderScope(typeProvider);
+					compiler = generateContractCode(*order[i], otherCompilers);
+				}
+				assembleContract(*order[i], optimiserParallelism);
+				lock_guard<mutex> lock(codegenMutex);
+				otherCompilers[order[i]] = compiler;
+			}).share();
+	}
+
+	// Report the first failure in the order of the serial compilation.
+	for (auto& result: results)
+		result.get();
+}
+
+shared_ptr<Compiler> CompilerStack::generateContractCode(
+	ContractDefinition const& _contract,
+	map<ContractDefinition const*, shared_ptr<Compiler const>> const& _otherCompilers
+)
+{
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_optimiserSettings);
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_optimiserSettings, m_yulFunctionCache);
 	compiledContract.compiler = compiler;
+	compiledContract.cachedArtifacts.reset();
 
 	bytes cborEncodedMetadata = createCBORMetadata(
 		metadata(compiledContract),
 		!onlySafeExperimentalFeaturesActivated(_contract.sourceUnit().annotation().experimentalFeatures)
 	);
 
+	compiler->generateCode(_contract, _otherCompilers, cborEncodedMetadata);
+	return compiler;
+}
+
+void CompilerStack::assembleContract(ContractDefinition const& _contract, unsigned _optimiserParallelism)
+{
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	solAssert(compiledContract.compiler, "");
+
 	try
 	{
-		// Run optimiser and compile the contract.
-		compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata);
+		// Run optimiser.
+		compiledContract.compiler->optimise(_optimiserParallelism);
 	}
 	catch(eth::OptimizerException const&)
 	{
@@ -977,7 +1338,7 @@ void CompilerStack::compileContract(
 	try
 	{
 		// Assemble deployment (incl. runtime)  object.
-		compiledContract.object = compiler->assembledObject();
+		compiledContract.object = compiledContract.compiler->assembledObject();
 	}
 	catch(eth::AssemblyException const&)
 	{
@@ -987,14 +1348,81 @@ void CompilerStack::compileContract(
 	try
 	{
 		// Assemble runtime object.
-		compiledContract.runtimeObject = compiler->runtimeObject();
+		compiledContract.runtimeObject = compiledContract.compiler->runtimeObject();
 	}
 	catch(eth::AssemblyException const&)
 	{
 		solAssert(false, "Assembly exception for deployed bytecode");
 	}
+}
 
-	_otherCompilers[compiledContract.contract] = compiler;
+h256 CompilerStack::artifactCacheKey(Contract const& _contract) const
+{
+	// The metadata contains the compiler version, the settings and the hashes of the sources
+	// the contract depends on. All other sources influence the AST IDs and the source indices.
+	string key = string(VersionString) + '\0' + metadata(_contract) + '\0';
+	for (auto const& source: m_sources)
+		key += source.first + '\0' + source.second.keccak256().hex() + '\0';
+	// The metadata only contains the optimiser settings that differ from the defaults.
+	for (bool flag: {
+		m_release,
+		m_optimiserSettings.runOrderLiterals,
+		m_optimiserSettings.runJumpdestRemover,
+		m_optimiserSettings.runPeephole,
+		m_optimiserSettings.runDeduplicate,
+		m_optimiserSettings.runCSE,
+		m_optimiserSettings.runConstantOptimiser,
+		m_optimiserSettings.optimizeStackAllocation,
+		m_optimiserSettings.runYulOptimiser
+	})
+		key += flag ? '1' : '0';
+	key += to_string(m_optimiserSettings.expectedExecutionsPerDeployment);
+	return keccak256(key);
+}
+
+bool CompilerStack::loadCachedArtifacts(ContractDefinition const& _contract)
+{
+	if (!_contract.canBeDeployed())
+		return false;
+
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	boost::optional<ArtifactCache::Artifacts> artifacts =
+		ArtifactCache(m_artifactCacheDirectory).load(artifactCacheKey(compiledContract));
+	if (!artifacts)
+		return false;
+
+	compiledContract.object = artifacts->object;
+	compiledContract.runtimeObject = artifacts->runtimeObject;
+	compiledContract.sourceMapping = make_unique<string const>(artifacts->sourceMapping);
+	compiledContract.runtimeSourceMapping = make_unique<string const>(artifacts->runtimeSourceMapping);
+	compiledContract.cachedArtifacts = make_shared<ArtifactCache::Artifacts const>(std::move(*artifacts));
+	return true;
+}
+
+void CompilerStack::storeArtifacts()
+{
+	ArtifactCache cache(m_artifactCacheDirectory);
+	StringMap const sources = sourceCodes();
+	for (auto const& contract: m_contracts)
+		if (shared_ptr<Compiler> const& compiler = contract.second.compiler)
+		{
+			ArtifactCache::Artifacts artifacts;
+			artifacts.object = contract.second.object;
+			artifacts.runtimeObject = contract.second.runtimeObject;
+			artifacts.sourceMapping = computeSourceMapping(compiler->assemblyItems());
+			artifacts.runtimeSourceMapping = computeSourceMapping(compiler->runtimeAssemblyItems());
+			artifacts.assembly = compiler->assemblyString(sources);
+			artifacts.assemblyJSON = jsonCompactPrint(compiler->assemblyJSON(sources));
+			cache.store(artifactCacheKey(contract.second), artifacts);
+		}
+}
+
+StringMap CompilerStack::sourceCodes() const
+{
+	StringMap sources;
+	for (auto const& source: m_sources)
+		sources[source.first] = source.second.scanner->source();
+	return sources;
 }
 
 void CompilerStack::generateIR(ContractDefinition const& _contract)
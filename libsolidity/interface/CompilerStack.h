@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <libsolidity/interface/ArtifactCache.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/Version.h>
@@ -70,9 +71,14 @@ class ContractDefinition;
 class FunctionDefinition;
 class SourceUnit;
 class Compiler;
+class YulFunctionCache;
 class GlobalContext;
 class Natspec;
 class DeclarationContainer;
+namespace smt
+{
+class SMTQueryCache;
+}
 
 /**
  * Easy to use and self-contained Solidity compiler with as few header dependencies as possible.
@@ -167,6 +173,31 @@ public:
 	/// Enable experimental generation of eWasm code. If enabled, IR is also generated.
 	void enableEWasmGeneration(bool _enable = true) { m_generateEWasm = _enable; }
 
+	/// Sets the number of contracts that may be compiled concurrently and the number of
+	/// SMT solvers the SMTChecker may query concurrently.
+	/// Values of zero and one result in serial compilation. The generated code does not
+	/// depend on this setting.
+	void setParallelism(unsigned _jobs = 1) { m_parallelism = _jobs; }
+
+	/// Stores the bytecode, assembly and source mappings of compiled contracts in @a _directory
+	/// and loads them from there instead of generating the code again if none of the inputs
+	/// changed. Contracts loaded from the cache have no assembly items, so gas estimates are
+	/// not available for them. An empty path disables the cache.
+	void setArtifactCacheDirectory(std::string _directory = std::string()) { m_artifactCacheDirectory = std::move(_directory); }
+
+	/// Sets a cache for the answers of the SMT solvers used by the SMTChecker. The cache can
+	/// be shared with other compiler stacks, also across threads. A null pointer disables it.
+	void setSMTQueryCache(std::shared_ptr<smt::SMTQueryCache> _queryCache) { m_smtQueryCache = std::move(_queryCache); }
+
+	/// Lets the SMTChecker query an SMT-LIB2 solver binary, given with its arguments in
+	/// @a _command, instead of returning the queries as unhandled queries. The solver process
+	/// is kept alive during the analysis of a source. An empty command disables it.
+	void setSMTSolverCommand(std::string _command = std::string()) { m_smtSolverCommand = std::move(_command); }
+
+	/// Lets the SMTChecker wait for the answers of all SMT solvers and report conflicting answers,
+	/// instead of using the answer of the first solver that answers.
+	void setSMTWaitForAllSolvers(bool _wait = true) { m_smtWaitForAllSolvers = _wait; }
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
 	/// Must be set before parsing.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
@@ -174,6 +205,14 @@ public:
 	/// Sets the sources. Must be set before parsing.
 	void setSources(StringMap _sources);
 
+	/// Replaces the sources of a previous run, keeping all settings. If the previous analysis
+	/// was successful, the next call to @a parse re-uses the AST and the analysis of every
+	/// source whose content is unchanged and which only imports such sources. The other
+	/// sources are parsed and analysed again. The result is identical to analysing all
+	/// sources from scratch.
+	/// Can be called in any state.
+	void updateSources(StringMap _sources);
+
 	/// Adds a response to an SMTLib2 query (identified by the hash of the query input).
 	/// Must be set before parsing.
 	void addSMTLib2Response(h256 const& _hash, std::string const& _response);
@@ -195,6 +234,11 @@ public:
 	/// @returns false on error.
 	bool compile();
 
+	/// Discards the results of a previous compilation but keeps the analysed sources,
+	/// so that @a compile can be called again, e.g. with a different selection of contracts.
+	/// Must be called after analysis.
+	void resetCompilation();
+
 	/// @returns the list of sources (paths) used
 	std::vector<std::string> sourceNames() const;
 
@@ -289,11 +333,35 @@ public:
 	/// Overwrites the release/prerelease flag. Should only be used for testing.
 	void overwriteReleaseFlag(bool release) { m_release = release; }
 private:
+	/// The steps of parsing and analysis for which errors are recorded per source.
+	enum AnalysisStep
+	{
+		Parsing,
+		SyntaxChecking,
+		DocStringAnalysis,
+		NameAndTypeResolution,
+		ContractLevelChecking,
+		TypeChecking,
+		PostTypeChecking,
+		ControlFlowGraphConstruction,
+		ControlFlowAnalysis,
+		StaticAnalysis,
+		AnalysisStepCount
+	};
+
 	/// The state per source unit. Filled gradually during parsing.
 	struct Source
 	{
 		std::shared_ptr<langutil::Scanner> scanner;
 		std::shared_ptr<SourceUnit> ast;
+		/// The range of IDs of the nodes of the AST: (idOffset, lastID].
+		size_t idOffset = 0;
+		size_t lastID = 0;
+		/// True if the AST and its analysis are re-used from a previous run.
+		bool reused = false;
+		/// The errors reported for this source during parsing and each analysis step,
+		/// indexed by AnalysisStep. These are reported again if the source is re-used.
+		std::vector<langutil::ErrorList> errors;
 		h256 mutable keccak256HashCached;
 		h256 mutable swarmHashCached;
 		std::string mutable ipfsUrlCached;
@@ -319,6 +387,8 @@ private:
 		mutable std::unique_ptr<Json::Value const> devDocumentation;
 		mutable std::unique_ptr<std::string const> sourceMapping;
 		mutable std::unique_ptr<std::string const> runtimeSourceMapping;
+		/// Artifacts loaded from the artifact cache if the contract was not compiled.
+		std::shared_ptr<ArtifactCache::Artifacts const> cachedArtifacts;
 	};
 
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
@@ -328,6 +398,19 @@ private:
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	void resolveImports();
 
+	/// Takes over the AST and the analysis of @a _previous for @a _source, moving the IDs of
+	/// the AST such that they follow the most recently created node.
+	void reuseSource(Source& _source, Source&& _previous);
+
+	/// Parses @a _source (named @a _path), records its errors and loads the sources it imports.
+	/// @returns the newly loaded sources.
+	StringMap parseSource(Source& _source, std::string const& _path);
+
+	/// Runs the analysis step @a _step via @a _analyze and records the errors it reports for
+	/// @a _source. If the source is re-used, only reports the previously recorded errors.
+	/// @returns false if the step failed.
+	bool analyzeSource(Source& _source, AnalysisStep _step, std::function<bool()> const& _analyze);
+
 	/// @returns true if the source is requested to be compiled.
 	bool isRequestedSource(std::string const& _sourceName) const;
 
@@ -342,6 +425,26 @@ private:
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
 	);
 
+	/// Compiles the given contracts and the contracts they depend on using a pool of
+	/// m_parallelism worker threads. A contract is only compiled after the contracts it
+	/// creates and after the earlier contracts that create one of them, but is otherwise
+	/// independent of the other contracts. The result is identical to calling
+	/// @a compileContract for each of @a _contracts in order.
+	void compileContractsInParallel(std::vector<ContractDefinition const*> const& _contracts);
+
+	/// Generates the unoptimised assembly for a single contract and stores its compiler.
+	/// This accesses state shared between all contracts (e.g. the type provider and the
+	/// annotations) and thus must not run concurrently with itself.
+	std::shared_ptr<Compiler> generateContractCode(
+		ContractDefinition const& _contract,
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers
+	);
+
+	/// Optimises and assembles the code previously generated for a single contract.
+	/// This only accesses the assembly of the contract and the assemblies of the contracts
+	/// it creates. The assembly optimiser uses @a _optimiserParallelism threads.
+	void assembleContract(ContractDefinition const& _contract, unsigned _optimiserParallelism = 1);
+
 	/// Generate Yul IR for a single contract.
 	/// The IR is stored but otherwise unused.
 	void generateIR(ContractDefinition const& _contract);
@@ -353,6 +456,19 @@ private:
 	/// library will still be kept as an unlinked placeholder in the objects.
 	void link();
 
+	/// @returns the hash of all inputs that influence the code generated for @a _contract.
+	h256 artifactCacheKey(Contract const& _contract) const;
+
+	/// Loads the artifacts of @a _contract from the artifact cache.
+	/// @returns false if they are not cached.
+	bool loadCachedArtifacts(ContractDefinition const& _contract);
+
+	/// Stores the artifacts of all contracts compiled in this run in the artifact cache.
+	void storeArtifacts();
+
+	/// @returns all sources as a map from names to contents.
+	StringMap sourceCodes() const;
+
 	/// @returns the contract object for the given @a _contractName.
 	/// Can only be called after state is CompilationSuccessful.
 	Contract const& contract(std::string const& _contractName) const;
@@ -403,15 +519,27 @@ private:
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
 	bool m_generateIR;
 	bool m_generateEWasm;
+	unsigned m_parallelism = 1;
+	std::string m_artifactCacheDirectory;
+	std::shared_ptr<smt::SMTQueryCache> m_smtQueryCache;
+	/// Yul helper functions shared between the contracts, only set during @a compile.
+	std::shared_ptr<YulFunctionCache> m_yulFunctionCache;
+	std::string m_smtSolverCommand;
+	bool m_smtWaitForAllSolvers = false;
 	std::map<std::string, h160> m_libraries;
 	/// list of path prefix remappings, e.g. mylibrary: github.com/ethereum = /usr/local/ethereum
 	/// "context:prefix=target"
 	std::vector<Remapping> m_remappings;
 	std::map<std::string const, Source> m_sources;
+	/// Sources of the previous run that can be re-used by the next call to @a parse.
+	std::map<std::string const, Source> m_previousSources;
+	/// ASTs of previous runs that are no longer used. They are kept alive because
+	/// some of the cached type information is keyed by the addresses of AST nodes.
+	std::vector<std::shared_ptr<SourceUnit>> m_replacedASTs;
 	std::vector<std::string> m_unhandledSMTLib2Queries;
 	std::map<h256, std::string> m_smtlib2Responses;
 	std::shared_ptr<GlobalContext> m_globalContext;
-	std::vector<Source const*> m_sourceOrder;
+	std::vector<Source*> m_sourceOrder;
 	/// This is updated during compilation.
 	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>> m_scopes;
 	std::map<std::string const, Contract> m_contracts;
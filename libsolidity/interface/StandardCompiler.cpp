@@ -28,6 +28,7 @@
 #include <libevmasm/Instruction.h>
 #include <libdevcore/JSON.h>
 #include <libdevcore/Keccak256.h>
+#include <libdevcore/ThreadPool.h>
 
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/algorithm/string.hpp>
@@ -349,7 +350,7 @@ boost::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 boost::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "evmVersion", "libraries", "metadata", "optimizer", "outputSelection", "remappings"};
+	static set<string> keys{"parserErrorRecovery", "evmVersion", "libraries", "metadata", "optimizer", "outputSelection", "parallelism", "remappings"};
 	return checkKeys(_input, keys, "settings");
 }
 
@@ -641,6 +642,15 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 		ret.evmVersion = *version;
 	}
 
+	if (settings.isMember("parallelism"))
+	{
+		if (!settings["parallelism"].isUInt())
+			return formatFatalError("JSONError", "\"settings.parallelism\" must be an unsigned integer.");
+		ret.parallelism = settings["parallelism"].asUInt();
+		if (ret.parallelism == 0)
+			ret.parallelism = ThreadPool::hardwareConcurrency();
+	}
+
 	if (settings.isMember("remappings") && !settings["remappings"].isArray())
 		return formatFatalError("JSONError", "\"settings.remappings\" must be an array of strings.");
 
@@ -723,18 +733,40 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 
 Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
 {
-	CompilerStack compilerStack(m_readFile);
-
-	StringMap sourceList = std::move(_inputsAndSettings.sources);
-	compilerStack.setSources(sourceList);
-	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
-		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
-	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
-	compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
-	compilerStack.setRemappings(_inputsAndSettings.remappings);
-	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
-	compilerStack.setLibraries(_inputsAndSettings.libraries);
-	compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
+	unique_ptr<CompilerStack> compilerStackPtr;
+	if (m_cachedCompilerStack && analysisSettingsEqual(m_cachedInputs, _inputsAndSettings))
+	{
+		compilerStackPtr = std::move(m_cachedCompilerStack);
+		// Sources loaded through the read callback are not part of the inputs and could
+		// have changed on disk, so they always have to be checked for updates.
+		if (
+			m_cachedInputs.sources == _inputsAndSettings.sources &&
+			compilerStackPtr->sourceNames().size() == _inputsAndSettings.sources.size()
+		)
+			compilerStackPtr->resetCompilation();
+		else
+			compilerStackPtr->updateSources(_inputsAndSettings.sources);
+	}
+	else
+	{
+		// The cached compiler stack has to be destroyed before a new one can be created.
+		m_cachedCompilerStack.reset();
+		compilerStackPtr = make_unique<CompilerStack>(m_readFile);
+		compilerStackPtr->setSources(_inputsAndSettings.sources);
+		for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
+			compilerStackPtr->addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
+		compilerStackPtr->setEVMVersion(_inputsAndSettings.evmVersion);
+		compilerStackPtr->setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
+		compilerStackPtr->setRemappings(_inputsAndSettings.remappings);
+		compilerStackPtr->setOptimiserSettings(_inputsAndSettings.optimiserSettings);
+		compilerStackPtr->setLibraries(_inputsAndSettings.libraries);
+		compilerStackPtr->useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
+	}
+	CompilerStack& compilerStack = *compilerStackPtr;
+
+	StringMap const& sourceList = _inputsAndSettings.sources;
+	compilerStack.setParallelism(_inputsAndSettings.parallelism);
+	compilerStack.setSMTQueryCache(m_smtQueryCache);
 	compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
 
 	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
@@ -969,10 +1001,35 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	if (!contractsOutput.empty())
 		output["contracts"] = contractsOutput;
 
+	if (m_analysisCacheEnabled && analysisPerformed && !compilerStack.hasError())
+	{
+		m_cachedCompilerStack = std::move(compilerStackPtr);
+		m_cachedInputs = std::move(_inputsAndSettings);
+	}
+
 	return output;
 }
 
 
+bool StandardCompiler::analysisSettingsEqual(InputsAndSettings const& _a, InputsAndSettings const& _b)
+{
+	auto remappingsEqual = [](CompilerStack::Remapping const& _x, CompilerStack::Remapping const& _y)
+	{
+		return _x.context == _y.context && _x.prefix == _y.prefix && _x.target == _y.target;
+	};
+	return
+		_a.language == _b.language &&
+		_a.smtLib2Responses == _b.smtLib2Responses &&
+		_a.evmVersion == _b.evmVersion &&
+		_a.parserErrorRecovery == _b.parserErrorRecovery &&
+		equal(_a.remappings.begin(), _a.remappings.end(), _b.remappings.begin(), _b.remappings.end(), remappingsEqual) &&
+		_a.optimiserSettings == _b.optimiserSettings &&
+		_a.libraries == _b.libraries &&
+		_a.metadataLiteralSources == _b.metadataLiteralSources &&
+		// The requested contracts determine which sources are analysed.
+		requestedContractNames(_a.outputSelection) == requestedContractNames(_b.outputSelection);
+}
+
 Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 {
 	if (_inputsAndSettings.sources.size() != 1)
@@ -1049,9 +1106,29 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 }
 
 
+void StandardCompiler::enableAnalysisCache(bool _enable, size_t _maxYulStrings)
+{
+	m_analysisCacheEnabled = _enable;
+	m_maxYulStrings = _maxYulStrings;
+	if (!_enable)
+	{
+		m_cachedCompilerStack.reset();
+		m_yulStringSession.reset();
+	}
+}
+
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
-	YulStringRepository::reset();
+	if (m_yulStringSession && YulStringRepository::instance().size() > m_maxYulStrings)
+	{
+		// Drop the cache, so that the session below can reset the repository.
+		m_cachedCompilerStack.reset();
+		m_yulStringSession.reset();
+	}
+	// Resets the Yul string repository unless other compilations are running concurrently.
+	YulStringRepository::Session yulStringSession;
+	if (m_analysisCacheEnabled && !m_yulStringSession)
+		m_yulStringSession = make_unique<YulStringRepository::Session>();
 
 	try
 	{
@@ -24,6 +24,8 @@
 
 #include <libsolidity/interface/CompilerStack.h>
 
+#include <libyul/YulString.h>
+
 #include <boost/optional.hpp>
 #include <boost/variant.hpp>
 
@@ -55,6 +57,18 @@ public:
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
 
+	/// Keeps the analysed sources of the last Solidity compilation, so that a following input
+	/// with the same settings only has to analyse the sources that changed (and the sources
+	/// that import them) before generating code for the requested outputs.
+	/// Since the kept CompilerStack occupies the type provider of the current thread, no other
+	/// CompilerStack may be used in this thread while the cache is enabled.
+	/// The kept sources reference Yul strings, so the Yul string repository is only reset once
+	/// it holds more than @a _maxYulStrings strings. The cache is dropped at that point.
+	void enableAnalysisCache(bool _enable = true, size_t _maxYulStrings = 1000000);
+
+	/// Sets the cache for the answers of the SMT solvers that is used by all following compilations.
+	void setSMTQueryCache(std::shared_ptr<smt::SMTQueryCache> _queryCache) { m_smtQueryCache = std::move(_queryCache); }
+
 private:
 	struct InputsAndSettings
 	{
@@ -66,6 +80,7 @@ private:
 		langutil::EVMVersion evmVersion;
 		std::vector<CompilerStack::Remapping> remappings;
 		OptimiserSettings optimiserSettings = OptimiserSettings::minimal();
+		unsigned parallelism = 1;
 		std::map<std::string, h160> libraries;
 		bool metadataLiteralSources = false;
 		Json::Value outputSelection;
@@ -78,7 +93,19 @@ private:
 	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
+	/// @returns true if all settings that affect the analysis are equal.
+	static bool analysisSettingsEqual(InputsAndSettings const& _a, InputsAndSettings const& _b);
+
 	ReadCallback::Callback m_readFile;
+
+	bool m_analysisCacheEnabled = false;
+	size_t m_maxYulStrings = 0;
+	/// Keeps the Yul strings of the cached compiler stack valid while the analysis cache is enabled.
+	std::unique_ptr<yul::YulStringRepository::Session> m_yulStringSession;
+	/// The compiler stack of the last Solidity compilation and its inputs, if kept by the analysis cache.
+	std::unique_ptr<CompilerStack> m_cachedCompilerStack;
+	InputsAndSettings m_cachedInputs;
+	std::shared_ptr<smt::SMTQueryCache> m_smtQueryCache;
 };
 
 }
@@ -26,6 +26,7 @@
 
 #include <libyul/Object.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/optimiser/Suite.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
@@ -81,6 +82,15 @@ public:
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
 	void optimize();
 
+	/// Sets the number of threads the optimizer suite uses to optimize functions concurrently.
+	/// The result does not depend on this setting.
+	void setParallelism(unsigned _jobs = 1) { m_parallelism = _jobs; }
+
+	/// Enables the collection of statistics by the optimizer suite in subsequent calls to @a optimize.
+	void enableOptimiserStatistics() { m_optimiserStatistics = std::make_shared<OptimiserStatistics>(); }
+	/// @returns the statistics collected by the optimizer suite or nullptr if not enabled.
+	OptimiserStatistics const* optimiserStatistics() const { return m_optimiserStatistics.get(); }
+
 	/// Run the assembly step (should only be called after parseAndAnalyze).
 	MachineAssemblyObject assemble(Machine _machine) const;
 
@@ -104,6 +114,8 @@ private:
 	Language m_language = Language::Assembly;
 	langutil::EVMVersion m_evmVersion;
 	dev::solidity::OptimiserSettings m_optimiserSettings;
+	std::shared_ptr<OptimiserStatistics> m_optimiserStatistics;
+	unsigned m_parallelism = 1;
 
 	std::shared_ptr<langutil::Scanner> m_scanner;
 
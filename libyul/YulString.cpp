@@ -0,0 +1,137 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * String abstraction that avoids copies.
+ */
+
+#include <libyul/YulString.h>
+
+#include <libyul/Exceptions.h>
+
+using namespace std;
+using namespace yul;
+
+YulStringRepository::Handle YulStringRepository::stringToHandle(string const& _string)
+{
+	if (_string.empty())
+		return { 0, emptyHash() };
+	std::uint64_t h = hash(_string);
+
+	// The lower bits of the hash select the slot, so the shard is selected by the upper bits.
+	Shard& shard = m_shards[(h >> 32) % c_shards];
+	lock_guard<mutex> lock(shard.mutex);
+	size_t mask = shard.slots.size() - 1;
+	size_t index = h & mask;
+	for (; shard.slots[index].id != 0; index = (index + 1) & mask)
+		if (shard.slots[index].hash == h && idToString(shard.slots[index].id) == _string)
+			return Handle{shard.slots[index].id, h};
+
+	size_t id = store(_string);
+	shard.slots[index] = {h, id};
+	// Keep the load factor below one half.
+	if (++shard.size * 2 > shard.slots.size())
+	{
+		vector<Shard::Slot> slots(shard.slots.size() * 2);
+		mask = slots.size() - 1;
+		for (Shard::Slot const& slot: shard.slots)
+			if (slot.id != 0)
+			{
+				index = slot.hash & mask;
+				while (slots[index].id != 0)
+					index = (index + 1) & mask;
+				slots[index] = slot;
+			}
+		shard.slots = move(slots);
+	}
+
+	return Handle{id, h};
+}
+
+size_t YulStringRepository::store(string const& _string)
+{
+	size_t id = m_size++;
+	yulAssert(id / c_chunkSize < c_maxChunks, "Too many Yul strings.");
+	atomic<string*>& chunkPointer = m_chunks[id / c_chunkSize];
+	string* chunk = chunkPointer.load(memory_order_acquire);
+	if (!chunk)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		chunk = chunkPointer.load(memory_order_acquire);
+		if (!chunk)
+		{
+			chunk = new string[c_chunkSize];
+			chunkPointer.store(chunk, memory_order_release);
+		}
+	}
+	// The string is published to other threads via the lock of the shard.
+	chunk[id % c_chunkSize] = _string;
+	return id;
+}
+
+void YulStringRepository::reset()
+{
+	vector<function<void()>> callbacks;
+	{
+		lock_guard<mutex> lock(instance().m_mutex);
+		callbacks = resetCallbacks();
+	}
+	for (auto const& cb: callbacks)
+		cb();
+	instance().clear();
+}
+
+YulStringRepository::ResetCallback::ResetCallback(function<void()> _fun)
+{
+	lock_guard<mutex> lock(instance().m_mutex);
+	YulStringRepository::resetCallbacks().emplace_back(move(_fun));
+}
+
+YulStringRepository::Session::Session()
+{
+	YulStringRepository& repository = instance();
+	lock_guard<mutex> lock(repository.m_sessionMutex);
+	if (repository.m_sessions++ == 0)
+		reset();
+}
+
+YulStringRepository::Session::~Session()
+{
+	YulStringRepository& repository = instance();
+	lock_guard<mutex> lock(repository.m_sessionMutex);
+	--repository.m_sessions;
+}
+
+YulStringRepository::~YulStringRepository()
+{
+	for (auto& chunk: m_chunks)
+		delete[] chunk.load();
+}
+
+void YulStringRepository::clear()
+{
+	for (Shard& shard: m_shards)
+	{
+		lock_guard<mutex> lock(shard.mutex);
+		shard.slots = vector<Shard::Slot>(64);
+		shard.size = 0;
+	}
+	lock_guard<mutex> lock(m_mutex);
+	for (auto& chunk: m_chunks)
+		delete[] chunk.exchange(nullptr);
+	m_chunks[0] = new string[c_chunkSize];
+	m_size = 1;
+}
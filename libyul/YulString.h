@@ -22,8 +22,10 @@
 
 #include <boost/noncopyable.hpp>
 
-#include <unordered_map>
+#include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <functional>
@@ -35,7 +37,11 @@ namespace yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
-class YulStringRepository
+/// The repository is shared by all threads. The lookup table is split into shards selected by
+/// the string hash, each with its own lock, so that threads interning different strings rarely
+/// wait for each other. Looking up the string of an ID does not require synchronization, since
+/// stored strings never move.
+class YulStringRepository: boost::noncopyable
 {
 public:
 	struct Handle
@@ -50,26 +56,15 @@ public:
 		return inst;
 	}
 
-	Handle stringToHandle(std::string const& _string)
+	Handle stringToHandle(std::string const& _string);
+	std::string const& idToString(size_t _id) const
 	{
-		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
+		return m_chunks[_id / c_chunkSize].load(std::memory_order_acquire)[_id % c_chunkSize];
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
 
 	static std::uint64_t hash(std::string const& v)
 	{
-		// FNV hash - can be replaced by a better one, e.g. xxhash64
+		// FNV hash - the order of YulStrings and thus the output of the optimiser depends on it.
 		std::uint64_t hash = emptyHash();
 		for (auto c: v)
 		{
@@ -80,32 +75,54 @@ public:
 		return hash;
 	}
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
+	/// @returns the number of strings stored in the repository, including the empty string.
+	size_t size() const { return m_size; }
 	/// Clear the repository.
-	/// Use with care - there cannot be any dangling YulString references.
+	/// Use with care - there cannot be any dangling YulString references, also not in other threads.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
-	static void reset()
-	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
-	}
+	static void reset();
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
 	struct ResetCallback
 	{
-		ResetCallback(std::function<void()> _fun)
-		{
-			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
-		}
+		ResetCallback(std::function<void()> _fun);
+	};
+	/// Marks the repository as used by a compilation for the lifetime of the object.
+	/// The repository is reset when a session starts while no other session is active.
+	/// This frees the memory in long-running processes but keeps the strings of
+	/// concurrently running compilations valid.
+	class Session: boost::noncopyable
+	{
+	public:
+		Session();
+		~Session();
 	};
 
 private:
-	YulStringRepository() = default;
-	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
-	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
+	/// Open addressing hash table from string hashes to IDs. Slots with ID zero are empty,
+	/// since the empty string is never inserted.
+	struct Shard
+	{
+		struct Slot
+		{
+			std::uint64_t hash = 0;
+			size_t id = 0;
+		};
+
+		std::mutex mutex;
+		std::vector<Slot> slots;
+		size_t size = 0;
+	};
+
+	YulStringRepository() { clear(); }
+	~YulStringRepository();
+
+	/// Removes all strings except the empty string.
+	void clear();
+
+	/// Stores @a _string in a new slot. @returns its ID.
+	size_t store(std::string const& _string);
 
 	static std::vector<std::function<void()>>& resetCallbacks()
 	{
@@ -113,8 +130,19 @@ private:
 		return callbacks;
 	}
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	static size_t constexpr c_chunkSize = 4096;
+	static size_t constexpr c_maxChunks = 1 << 16;
+	static size_t constexpr c_shards = 16;
+
+	std::array<Shard, c_shards> m_shards;
+	/// Guards the allocation of chunks and the reset callbacks.
+	std::mutex m_mutex;
+	/// Storage of the strings, allocated in chunks of fixed size such that they never move.
+	std::array<std::atomic<std::string*>, c_maxChunks> m_chunks{};
+	std::atomic<size_t> m_size{0};
+
+	std::mutex m_sessionMutex;
+	size_t m_sessions = 0;
 };
 
 /// Wrapper around handles into the YulString repository.
@@ -34,12 +34,21 @@
 
 #include <boost/range/adaptor/reversed.hpp>
 
+#include <mutex>
+
 using namespace std;
 using namespace dev;
 using namespace yul;
 
 namespace
 {
+/// Guards the dialect caches, which are shared by all threads.
+mutex& dialectsMutex()
+{
+	static mutex dialectsMutex;
+	return dialectsMutex;
+}
+
 pair<YulString, BuiltinFunctionForEVM> createEVMFunction(
 	string const& _name,
 	dev::eth::Instruction _instruction
@@ -188,7 +197,11 @@ BuiltinFunctionForEVM const* EVMDialect::builtin(YulString _name) const
 EVMDialect const& EVMDialect::looseAssemblyForEVM(langutil::EVMVersion _version)
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static YulStringRepository::ResetCallback callback{[&] {
+		lock_guard<mutex> lock(dialectsMutex());
+		dialects.clear();
+	}};
+	lock_guard<mutex> lock(dialectsMutex());
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialect>(AsmFlavour::Loose, false, _version);
 	return *dialects[_version];
@@ -197,7 +210,11 @@ EVMDialect const& EVMDialect::looseAssemblyForEVM(langutil::EVMVersion _version)
 EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _version)
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static YulStringRepository::ResetCallback callback{[&] {
+		lock_guard<mutex> lock(dialectsMutex());
+		dialects.clear();
+	}};
+	lock_guard<mutex> lock(dialectsMutex());
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialect>(AsmFlavour::Strict, false, _version);
 	return *dialects[_version];
@@ -206,7 +223,11 @@ EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _version
 EVMDialect const& EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion _version)
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static YulStringRepository::ResetCallback callback{[&] {
+		lock_guard<mutex> lock(dialectsMutex());
+		dialects.clear();
+	}};
+	lock_guard<mutex> lock(dialectsMutex());
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialect>(AsmFlavour::Strict, true, _version);
 	return *dialects[_version];
@@ -215,7 +236,11 @@ EVMDialect const& EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion _
 EVMDialect const& EVMDialect::yulForEVM(langutil::EVMVersion _version)
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static YulStringRepository::ResetCallback callback{[&] {
+		lock_guard<mutex> lock(dialectsMutex());
+		dialects.clear();
+	}};
+	lock_guard<mutex> lock(dialectsMutex());
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialect>(AsmFlavour::Yul, false, _version);
 	return *dialects[_version];
@@ -20,6 +20,8 @@
 
 #include <libyul/backends/wasm/WasmDialect.h>
 
+#include <mutex>
+
 using namespace std;
 using namespace yul;
 
@@ -81,7 +83,12 @@ BuiltinFunction const* WasmDialect::builtin(YulString _name) const
 WasmDialect const& WasmDialect::instance()
 {
 	static std::unique_ptr<WasmDialect> dialect;
-	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
+	static mutex dialectMutex;
+	static YulStringRepository::ResetCallback callback{[&] {
+		lock_guard<mutex> lock(dialectMutex);
+		dialect.reset();
+	}};
+	lock_guard<mutex> lock(dialectMutex);
 	if (!dialect)
 		dialect = make_unique<WasmDialect>();
 	return *dialect;
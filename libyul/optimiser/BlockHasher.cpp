@@ -193,3 +193,140 @@ void BlockHasher::operator()(Block const& _block)
 	for (auto& externalReference: subBlockHasher.m_externalReferences)
 		(*this)(Identifier{{}, externalReference});
 }
+
+uint64_t ASTHasher::run(Block const& _block)
+{
+	ASTHasher hasher;
+	hasher(_block);
+	return hasher.m_hash;
+}
+
+void ASTHasher::operator()(Literal const& _literal)
+{
+	hash64(compileTimeLiteralHash("Literal"));
+	hash64(_literal.value.hash());
+	hash64(_literal.type.hash());
+	hash64(static_cast<uint64_t>(_literal.kind));
+}
+
+void ASTHasher::operator()(Instruction const& _instruction)
+{
+	hash64(compileTimeLiteralHash("Instruction"));
+	hash64(static_cast<std::underlying_type_t<eth::Instruction>>(_instruction.instruction));
+}
+
+void ASTHasher::operator()(Identifier const& _identifier)
+{
+	auto variable = m_variables.find(_identifier.name);
+	if (variable != m_variables.end())
+	{
+		hash64(compileTimeLiteralHash("Variable"));
+		hash64(variable->second);
+	}
+	else
+	{
+		hash64(compileTimeLiteralHash("Identifier"));
+		hash64(_identifier.name.hash());
+	}
+}
+
+void ASTHasher::operator()(FunctionalInstruction const& _instr)
+{
+	hash64(compileTimeLiteralHash("FunctionalInstruction"));
+	hash64(static_cast<std::underlying_type_t<eth::Instruction>>(_instr.instruction));
+	hash64(_instr.arguments.size());
+	ASTWalker::operator()(_instr);
+}
+
+void ASTHasher::operator()(FunctionCall const& _funCall)
+{
+	hash64(compileTimeLiteralHash("FunctionCall"));
+	hash64(_funCall.functionName.name.hash());
+	hash64(_funCall.arguments.size());
+	ASTWalker::operator()(_funCall);
+}
+
+void ASTHasher::operator()(ExpressionStatement const& _statement)
+{
+	hash64(compileTimeLiteralHash("ExpressionStatement"));
+	ASTWalker::operator()(_statement);
+}
+
+void ASTHasher::operator()(Assignment const& _assignment)
+{
+	hash64(compileTimeLiteralHash("Assignment"));
+	hash64(_assignment.variableNames.size());
+	ASTWalker::operator()(_assignment);
+}
+
+void ASTHasher::operator()(VariableDeclaration const& _varDecl)
+{
+	hash64(compileTimeLiteralHash("VariableDeclaration"));
+	hash64(_varDecl.value ? 1 : 0);
+	// The value is visited first because the variables are not yet in scope there.
+	ASTWalker::operator()(_varDecl);
+	declare(_varDecl.variables);
+}
+
+void ASTHasher::operator()(If const& _if)
+{
+	hash64(compileTimeLiteralHash("If"));
+	ASTWalker::operator()(_if);
+}
+
+void ASTHasher::operator()(Switch const& _switch)
+{
+	hash64(compileTimeLiteralHash("Switch"));
+	hash64(_switch.cases.size());
+	visit(*_switch.expression);
+	for (auto const& _case: _switch.cases)
+	{
+		if (_case.value)
+			(*this)(*_case.value);
+		else
+			hash64(compileTimeLiteralHash("Default"));
+		(*this)(_case.body);
+	}
+}
+
+void ASTHasher::operator()(FunctionDefinition const& _funDef)
+{
+	hash64(compileTimeLiteralHash("FunctionDefinition"));
+	hash64(_funDef.name.hash());
+	declare(_funDef.parameters);
+	declare(_funDef.returnVariables);
+	ASTWalker::operator()(_funDef);
+}
+
+void ASTHasher::operator()(ForLoop const& _loop)
+{
+	hash64(compileTimeLiteralHash("ForLoop"));
+	ASTWalker::operator()(_loop);
+}
+
+void ASTHasher::operator()(Break const&)
+{
+	hash64(compileTimeLiteralHash("Break"));
+}
+
+void ASTHasher::operator()(Continue const&)
+{
+	hash64(compileTimeLiteralHash("Continue"));
+}
+
+void ASTHasher::operator()(Block const& _block)
+{
+	hash64(compileTimeLiteralHash("Block"));
+	hash64(_block.statements.size());
+	ASTWalker::operator()(_block);
+}
+
+void ASTHasher::declare(TypedNameList const& _names)
+{
+	hash64(_names.size());
+	for (auto const& name: _names)
+	{
+		hash64(name.type.hash());
+		m_variables[name.name] = m_variableCount++;
+	}
+}
@@ -105,5 +105,58 @@ private:
 	size_t m_internalIdentifierCount = 0;
 };
 
+/**
+ * Optimiser component that calculates a hash value for a whole block, which can
+ * be used to detect whether an optimiser step changed the code.
+ *
+ * In contrast to the BlockHasher, the order of switch cases and the names of
+ * functions and undeclared identifiers are taken into account. Declared variables
+ * are replaced by a counter in the order of their declaration, so that the
+ * fresh names introduced by the SSA transform do not count as a change.
+ *
+ * Prerequisite: Disambiguator
+ */
+class ASTHasher: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+
+	void operator()(Literal const& _literal) override;
+	void operator()(Instruction const& _instruction) override;
+	void operator()(Identifier const& _identifier) override;
+	void operator()(FunctionalInstruction const& _instr) override;
+	void operator()(FunctionCall const& _funCall) override;
+	void operator()(ExpressionStatement const& _statement) override;
+	void operator()(Assignment const& _assignment) override;
+	void operator()(VariableDeclaration const& _varDecl) override;
+	void operator()(If const& _if) override;
+	void operator()(Switch const& _switch) override;
+	void operator()(FunctionDefinition const& _funDef) override;
+	void operator()(ForLoop const& _loop) override;
+	void operator()(Break const&) override;
+	void operator()(Continue const&) override;
+	void operator()(Block const& _block) override;
+
+	static uint64_t run(Block const& _block);
+
+private:
+	ASTHasher() = default;
+
+	void hash64(uint64_t _value)
+	{
+		for (size_t i = 0; i < 8; ++i)
+		{
+			m_hash *= BlockHasher::fnvPrime;
+			m_hash ^= static_cast<uint8_t>(_value >> (8 * i));
+		}
+	}
+	/// Hashes the types of @a _names and declares them as variables.
+	void declare(TypedNameList const& _names);
+
+	uint64_t m_hash = BlockHasher::fnvEmptyHash;
+	std::map<YulString, size_t> m_variables;
+	size_t m_variableCount = 0;
+};
+
 
 }
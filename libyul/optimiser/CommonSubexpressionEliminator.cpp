@@ -36,11 +36,17 @@ using namespace yul;
 
 void CommonSubexpressionEliminator::run(Dialect const& _dialect, Block& _ast)
 {
-	CommonSubexpressionEliminator cse{
-		_dialect,
-		SideEffectsPropagator::sideEffects(_dialect, CallGraphGenerator::callGraph(_ast))
-	};
-	cse(_ast);
+	run(_dialect, _ast, SideEffectsPropagator::sideEffects(_dialect, CallGraphGenerator::callGraph(_ast)));
+}
+
+void CommonSubexpressionEliminator::run(
+	Dialect const& _dialect,
+	Block& _block,
+	map<YulString, SideEffects> _functionSideEffects
+)
+{
+	CommonSubexpressionEliminator cse{_dialect, std::move(_functionSideEffects)};
+	cse(_block);
 }
 
 CommonSubexpressionEliminator::CommonSubexpressionEliminator(
@@ -40,6 +40,14 @@ class CommonSubexpressionEliminator: public DataFlowAnalyzer
 public:
 	/// Runs the CSE pass. @a _ast needs to be the complete AST of the program!
 	static void run(Dialect const& _dialect, Block& _ast);
+	/// Runs the CSE pass on @a _block, which can also be a part of the AST containing
+	/// the main block or complete function definitions.
+	/// @a _functionSideEffects has to be computed from the complete AST.
+	static void run(
+		Dialect const& _dialect,
+		Block& _block,
+		std::map<YulString, SideEffects> _functionSideEffects
+	);
 
 private:
 	CommonSubexpressionEliminator(
@@ -34,11 +34,22 @@ using namespace yul;
 void LoadResolver::run(Dialect const& _dialect, Block& _ast)
 {
 	bool containsMSize = MSizeFinder::containsMSize(_dialect, _ast);
-	LoadResolver{
+	run(
 		_dialect,
+		_ast,
 		SideEffectsPropagator::sideEffects(_dialect, CallGraphGenerator::callGraph(_ast)),
 		!containsMSize
-	}(_ast);
+	);
+}
+
+void LoadResolver::run(
+	Dialect const& _dialect,
+	Block& _block,
+	map<YulString, SideEffects> _functionSideEffects,
+	bool _optimizeMLoad
+)
+{
+	LoadResolver{_dialect, std::move(_functionSideEffects), _optimizeMLoad}(_block);
 }
 
 void LoadResolver::visit(Expression& _e)
@@ -43,6 +43,16 @@ class LoadResolver: public DataFlowAnalyzer
 public:
 	/// Run the load resolver on the given complete AST.
 	static void run(Dialect const& _dialect, Block& _ast);
+	/// Run the load resolver on @a _block, which can also be a part of the AST containing
+	/// the main block or complete function definitions.
+	/// @a _functionSideEffects has to be computed from the complete AST and @a _optimizeMLoad
+	/// must only be set if the complete AST does not contain msize.
+	static void run(
+		Dialect const& _dialect,
+		Block& _block,
+		std::map<YulString, SideEffects> _functionSideEffects,
+		bool _optimizeMLoad
+	);
 
 private:
 	LoadResolver(
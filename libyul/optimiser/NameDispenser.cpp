@@ -46,18 +46,43 @@ NameDispenser::NameDispenser(Dialect const& _dialect, set<YulString> _usedNames)
 YulString NameDispenser::newName(YulString _nameHint)
 {
 	YulString name = _nameHint;
-	while (illegalName(name))
+	// Concurrent tasks could all return the hint itself, so they always add a suffix.
+	bool needsSuffix = m_parentUsedNames;
+	while (needsSuffix || illegalName(name))
 	{
-		m_counter++;
+		needsSuffix = false;
 		name = YulString(_nameHint.str() + "_" + to_string(m_counter));
+		m_counter += m_counterStep;
 	}
 	m_usedNames.emplace(name);
 	return name;
 }
 
+NameDispenser NameDispenser::concurrentTask(size_t _index, size_t _taskCount) const
+{
+	yulAssert(!m_parentUsedNames, "Dispensers of concurrent tasks cannot be nested.");
+	yulAssert(_index < _taskCount, "");
+	NameDispenser task(m_dialect, set<YulString>{});
+	task.m_parentUsedNames = &m_usedNames;
+	task.m_counter = _index + 1;
+	task.m_counterStep = _taskCount;
+	return task;
+}
+
+void NameDispenser::join(NameDispenser const& _task)
+{
+	yulAssert(_task.m_parentUsedNames == &m_usedNames, "");
+	m_usedNames += _task.m_usedNames;
+}
+
 bool NameDispenser::illegalName(YulString _name)
 {
-	if (_name.empty() || m_usedNames.count(_name) || m_dialect.builtin(_name))
+	if (
+		_name.empty() ||
+		m_usedNames.count(_name) ||
+		(m_parentUsedNames && m_parentUsedNames->count(_name)) ||
+		m_dialect.builtin(_name)
+	)
 		return true;
 	if (dynamic_cast<EVMDialect const*>(&m_dialect))
 		return Parser::instructions().count(_name.str());
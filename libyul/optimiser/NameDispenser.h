@@ -50,12 +50,26 @@ public:
 	/// return it.
 	void markUsed(YulString _name) { m_usedNames.insert(_name); }
 
+	/// @returns a dispenser for task @a _index of @a _taskCount tasks that run concurrently.
+	/// The names it returns are unused in this dispenser and distinct from the names returned
+	/// by the dispensers of the other tasks, independently of the order of the calls.
+	/// This dispenser must not be used until the tasks have finished and their
+	/// dispensers have been passed to @a join.
+	NameDispenser concurrentTask(size_t _index, size_t _taskCount) const;
+	/// Marks all names returned by the dispenser of a concurrent task as used.
+	void join(NameDispenser const& _task);
+
 private:
 	bool illegalName(YulString _name);
 
 	Dialect const& m_dialect;
 	std::set<YulString> m_usedNames;
-	size_t m_counter = 0;
+	/// Names used by the dispenser this dispenser of a concurrent task was created from.
+	std::set<YulString> const* m_parentUsedNames = nullptr;
+	/// The suffix appended next to the name hint and the step between consecutive suffixes.
+	/// Dispensers of concurrent tasks use disjoint sets of suffixes.
+	size_t m_counter = 1;
+	size_t m_counterStep = 1;
 };
 
 }
@@ -23,6 +23,7 @@
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/BlockFlattener.h>
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/ControlFlowSimplifier.h>
 #include <libyul/optimiser/DeadCodeEliminator.h>
@@ -47,193 +48,444 @@
 #include <libyul/optimiser/RedundantAssignEliminator.h>
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/LoadResolver.h>
-#include <libyul/optimiser/Metrics.h>
 #include <libyul/backends/evm/ConstantOptimiser.h>
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/AsmData.h>
 #include <libyul/AsmPrinter.h>
 #include <libyul/Object.h>
+#include <libyul/SideEffects.h>
 
 #include <libyul/backends/wasm/WasmDialect.h>
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <libdevcore/CommonData.h>
+#include <libdevcore/ThreadPool.h>
+
+#include <boost/format.hpp>
+
+#include <functional>
 
 using namespace std;
 using namespace dev;
 using namespace yul;
 
-void OptimiserSuite::run(
-	Dialect const& _dialect,
-	GasMeter const* _meter,
-	Object& _object,
-	bool _optimizeStackAllocation,
-	set<YulString> const& _externallyUsedIdentifiers
-)
+namespace
 {
-	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
-	reservedIdentifiers += _dialect.fixedFunctionNames();
 
-	*_object.code = boost::get<Block>(Disambiguator(
-		_dialect,
-		*_object.analysisInfo,
-		reservedIdentifiers
-	)(*_object.code));
-	Block& ast = *_object.code;
-
-	VarDeclInitializer{}(ast);
-	FunctionHoister{}(ast);
-	BlockFlattener{}(ast);
-	ForLoopInitRewriter{}(ast);
-	DeadCodeEliminator{_dialect}(ast);
-	FunctionGrouper{}(ast);
-	EquivalentFunctionCombiner::run(ast);
-	UnusedPruner::runUntilStabilisedOnFullAST(_dialect, ast, reservedIdentifiers);
-	BlockFlattener{}(ast);
-	ControlFlowSimplifier{_dialect}(ast);
-	LiteralRematerialiser{_dialect}(ast);
-	StructuralSimplifier{}(ast);
-	ControlFlowSimplifier{_dialect}(ast);
-	ForLoopConditionIntoBody{_dialect}(ast);
-	BlockFlattener{}(ast);
+/**
+ * An optimiser step. Steps that only change the main block and function definitions
+ * individually and do not need any information about other functions apart from what
+ * @a prepare computes from the complete AST can be applied to each function separately.
+ */
+struct OptimiserStep
+{
+	/// Applies the step to the complete AST.
+	function<void()> run = {};
+	/// If set, applies the step to a block that contains only the main block or a single
+	/// function definition, using the given name dispenser for new names.
+	function<void(Block&, NameDispenser&)> runOnFunction = {};
+	/// If set, computes the information needed by @a runOnFunction from the complete AST.
+	function<void()> prepare = {};
+};
 
-	// None of the above can make stack problems worse.
+/**
+ * Runs optimiser steps by name and keeps track of changes to the code in order
+ * to skip groups of steps that cannot change it. Collects statistics if requested.
+ *
+ * Once the name dispenser has been created and the code is grouped into the main block and
+ * function definitions, function-local steps are applied to each of them separately, concurrently
+ * if more than one thread is used. The name dispensers of the individual functions only depend
+ * on the position of the function, so the result does not depend on the number of threads.
+ */
+class StepRunner
+{
+public:
+	StepRunner(
+		map<string, OptimiserStep> _steps,
+		Block& _ast,
+		unique_ptr<NameDispenser> const& _dispenser,
+		size_t _threads,
+		OptimiserStatistics* _statistics
+	):
+		m_steps(std::move(_steps)),
+		m_ast(_ast),
+		m_dispenser(_dispenser),
+		m_statistics(_statistics)
+	{
+		if (_threads > 1)
+			m_threadPool = make_unique<ThreadPool>(_threads);
+	}
 
-	NameDispenser dispenser{_dialect, ast, reservedIdentifiers};
+	/// Runs the steps @a _sequence in order.
+	void runSequence(vector<string> const& _sequence)
+	{
+		for (string const& step: _sequence)
+			runStep(step);
+	}
 
-	size_t codeSize = 0;
-	for (size_t rounds = 0; rounds < 12; ++rounds)
+	/// Runs the steps @a _sequence in order unless the previous run of the group named @a _group
+	/// did not change the code and the code did not change since then. Since all steps are
+	/// deterministic, running the group again would not change the code either.
+	void runGroup(string const& _group, vector<string> const& _sequence)
 	{
+		uint64_t hashBefore = hash();
+		auto unchanged = m_unchangedGroups.find(_group);
+		if (unchanged != m_unchangedGroups.end() && unchanged->second == hashBefore)
 		{
-			size_t newSize = CodeSize::codeSizeIncludingFunctions(ast);
-			if (newSize == codeSize)
-				break;
-			codeSize = newSize;
+			if (m_statistics)
+				m_statistics->groupsSkipped++;
+			return;
 		}
 
-		{
-			// Turn into SSA and simplify
-			ExpressionSplitter{_dialect, dispenser}(ast);
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(_dialect, ast);
-			RedundantAssignEliminator::run(_dialect, ast);
-
-			ExpressionSimplifier::run(_dialect, ast);
+		if (m_statistics)
+			m_statistics->groupsRun++;
+		runSequence(_sequence);
 
-			CommonSubexpressionEliminator::run(_dialect, ast);
-			LoadResolver::run(_dialect, ast);
-		}
+		uint64_t hashAfter = hash();
+		if (hashAfter == hashBefore)
+			m_unchangedGroups[_group] = hashAfter;
+		else
+			m_unchangedGroups.erase(_group);
+	}
 
-		{
-			// still in SSA, perform structural simplification
-			ControlFlowSimplifier{_dialect}(ast);
-			LiteralRematerialiser{_dialect}(ast);
-			StructuralSimplifier{}(ast);
-			ControlFlowSimplifier{_dialect}(ast);
-			BlockFlattener{}(ast);
-			DeadCodeEliminator{_dialect}(ast);
-			UnusedPruner::runUntilStabilisedOnFullAST(_dialect, ast, reservedIdentifiers);
-		}
+	/// @returns the hash of the code, which is only re-computed if a step was run since the last call.
+	uint64_t hash()
+	{
+		if (!m_hash)
+			m_hash = ASTHasher::run(m_ast);
+		return *m_hash;
+	}
 
-		{
-			// simplify again
-			LoadResolver::run(_dialect, ast);
-			CommonSubexpressionEliminator::run(_dialect, ast);
-			UnusedPruner::runUntilStabilisedOnFullAST(_dialect, ast, reservedIdentifiers);
-		}
+private:
+	void runStep(string const& _step)
+	{
+		auto step = m_steps.find(_step);
+		yulAssert(step != m_steps.end(), "Unknown optimiser step: " + _step);
 
+		if (!m_statistics)
 		{
-			// reverse SSA
-			SSAReverser::run(ast);
-			CommonSubexpressionEliminator::run(_dialect, ast);
-			UnusedPruner::runUntilStabilisedOnFullAST(_dialect, ast, reservedIdentifiers);
-
-			ExpressionJoiner::run(ast);
-			ExpressionJoiner::run(ast);
+			apply(step->second);
+			m_hash.reset();
+			return;
 		}
 
-		// should have good "compilability" property here.
+		// Hashing is only done per step when collecting statistics and is not included in the timing.
+		uint64_t hashBefore = hash();
+		auto start = chrono::steady_clock::now();
+		apply(step->second);
+		OptimiserStatistics::Step& statistics = m_statistics->steps[_step];
+		statistics.time += chrono::steady_clock::now() - start;
+		statistics.runs++;
+		m_hash.reset();
+		if (hash() != hashBefore)
+			statistics.changes++;
+	}
 
+	void apply(OptimiserStep const& _step)
+	{
+		if (!_step.runOnFunction || !m_dispenser || !FunctionGrouper::alreadyGrouped(m_ast))
 		{
-			// run functional expression inliner
-			ExpressionInliner(_dialect, ast).run();
-			UnusedPruner::runUntilStabilisedOnFullAST(_dialect, ast, reservedIdentifiers);
+			_step.run();
+			return;
 		}
 
+		if (_step.prepare)
+			_step.prepare();
+
+		size_t const count = m_ast.statements.size();
+		vector<Block> functions(count);
+		vector<NameDispenser> dispensers;
+		dispensers.reserve(count);
+		for (size_t i = 0; i < count; ++i)
 		{
-			// Turn into SSA again and simplify
-			ExpressionSplitter{_dialect, dispenser}(ast);
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(_dialect, ast);
-			RedundantAssignEliminator::run(_dialect, ast);
-			CommonSubexpressionEliminator::run(_dialect, ast);
-			LoadResolver::run(_dialect, ast);
+			functions[i].statements.emplace_back(std::move(m_ast.statements[i]));
+			dispensers.emplace_back(m_dispenser->concurrentTask(i, count));
 		}
 
+		if (m_threadPool)
 		{
-			// run full inliner
-			FunctionGrouper{}(ast);
-			EquivalentFunctionCombiner::run(ast);
-			FullInliner{ast, dispenser}.run();
-			BlockFlattener{}(ast);
+			vector<future<void>> results;
+			for (size_t i = 0; i < count; ++i)
+				results.emplace_back(m_threadPool->submit([&, i]() {
+					_step.runOnFunction(functions[i], dispensers[i]);
+				}));
+			// All tasks have to finish before an exception is re-thrown, since they access local variables.
+			for (auto& result: results)
+				result.wait();
+			for (auto& result: results)
+				result.get();
 		}
+		else
+			for (size_t i = 0; i < count; ++i)
+				_step.runOnFunction(functions[i], dispensers[i]);
 
+		for (size_t i = 0; i < count; ++i)
 		{
-			// SSA plus simplify
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(_dialect, ast);
-			RedundantAssignEliminator::run(_dialect, ast);
-			LoadResolver::run(_dialect, ast);
-			ExpressionSimplifier::run(_dialect, ast);
-			LiteralRematerialiser{_dialect}(ast);
-			StructuralSimplifier{}(ast);
-			BlockFlattener{}(ast);
-			DeadCodeEliminator{_dialect}(ast);
-			ControlFlowSimplifier{_dialect}(ast);
-			CommonSubexpressionEliminator::run(_dialect, ast);
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(_dialect, ast);
-			RedundantAssignEliminator::run(_dialect, ast);
-			UnusedPruner::runUntilStabilisedOnFullAST(_dialect, ast, reservedIdentifiers);
-			CommonSubexpressionEliminator::run(_dialect, ast);
+			yulAssert(functions[i].statements.size() == 1, "Function-local step changed the structure of the code.");
+			m_ast.statements[i] = std::move(functions[i].statements.front());
+			m_dispenser->join(dispensers[i]);
 		}
 	}
 
-	// Make source short and pretty.
+	map<string, OptimiserStep> const m_steps;
+	Block& m_ast;
+	unique_ptr<NameDispenser> const& m_dispenser;
+	unique_ptr<ThreadPool> m_threadPool;
+	OptimiserStatistics* m_statistics = nullptr;
+	/// Hash of the code, reset whenever a step is run.
+	boost::optional<uint64_t> m_hash;
+	/// Hash of the code after the last run of a group, if that run did not change the code.
+	map<string, uint64_t> m_unchangedGroups;
+};
+
+}
+
+string OptimiserStatistics::toString() const
+{
+	string result =
+		"Rounds: " + to_string(rounds) +
+		", step groups run: " + to_string(groupsRun) +
+		", skipped: " + to_string(groupsSkipped) + "\n";
+	result += (boost::format("%-34s %8s %8s %12s\n") % "Step" % "Runs" % "Changes" % "Time (ms)").str();
+	for (auto const& step: steps)
+		result += (
+			boost::format("%-34s %8d %8d %12.3f\n") %
+			step.first %
+			step.second.runs %
+			step.second.changes %
+			chrono::duration<double, milli>(step.second.time).count()
+		).str();
+	return result;
+}
 
-	ExpressionJoiner::run(ast);
-	Rematerialiser::run(_dialect, ast);
-	UnusedPruner::runUntilStabilisedOnFullAST(_dialect, ast, reservedIdentifiers);
-	ExpressionJoiner::run(ast);
-	UnusedPruner::runUntilStabilisedOnFullAST(_dialect, ast, reservedIdentifiers);
-	ExpressionJoiner::run(ast);
-	UnusedPruner::runUntilStabilisedOnFullAST(_dialect, ast, reservedIdentifiers);
+void OptimiserSuite::run(
+	Dialect const& _dialect,
+	GasMeter const* _meter,
+	Object& _object,
+	bool _optimizeStackAllocation,
+	set<YulString> const& _externallyUsedIdentifiers,
+	OptimiserStatistics* _statistics,
+	size_t _threads
+)
+{
+	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
+	reservedIdentifiers += _dialect.fixedFunctionNames();
 
-	SSAReverser::run(ast);
-	CommonSubexpressionEliminator::run(_dialect, ast);
-	UnusedPruner::runUntilStabilisedOnFullAST(_dialect, ast, reservedIdentifiers);
+	*_object.code = boost::get<Block>(Disambiguator(
+		_dialect,
+		*_object.analysisInfo,
+		reservedIdentifiers
+	)(*_object.code));
+	Block& ast = *_object.code;
 
-	ExpressionJoiner::run(ast);
-	Rematerialiser::run(_dialect, ast);
-	UnusedPruner::runUntilStabilisedOnFullAST(_dialect, ast, reservedIdentifiers);
+	// Created after the initial simplifications below.
+	unique_ptr<NameDispenser> dispenser;
 
 	// This is a tuning parameter, but actually just prevents infinite loops.
 	size_t stackCompressorMaxIterations = 16;
-	FunctionGrouper{}(ast);
-	// We ignore the return value because we will get a much better error
-	// message once we perform code generation.
-	StackCompressor::run(
-		_dialect,
-		_object,
-		_optimizeStackAllocation,
-		stackCompressorMaxIterations
-	);
-	BlockFlattener{}(ast);
-	DeadCodeEliminator{_dialect}(ast);
-	ControlFlowSimplifier{_dialect}(ast);
 
-	FunctionGrouper{}(ast);
+	// Information about the complete AST computed by function-local steps.
+	map<YulString, SideEffects> functionSideEffects;
+	bool optimizeMLoad = false;
+
+	StepRunner runner({
+		{"BlockFlattener", {[&]() { BlockFlattener{}(ast); }}},
+		{"CommonSubexpressionEliminator", {
+			[&]() { CommonSubexpressionEliminator::run(_dialect, ast); },
+			[&](Block& _block, NameDispenser&) { CommonSubexpressionEliminator::run(_dialect, _block, functionSideEffects); },
+			[&]() { functionSideEffects = SideEffectsPropagator::sideEffects(_dialect, CallGraphGenerator::callGraph(ast)); }
+		}},
+		{"ControlFlowSimplifier", {[&]() { ControlFlowSimplifier{_dialect}(ast); }}},
+		{"DeadCodeEliminator", {
+			[&]() { DeadCodeEliminator{_dialect}(ast); },
+			[&](Block& _block, NameDispenser&) { DeadCodeEliminator{_dialect}(_block); }
+		}},
+		{"EquivalentFunctionCombiner", {[&]() { EquivalentFunctionCombiner::run(ast); }}},
+		{"ExpressionInliner", {[&]() { ExpressionInliner(_dialect, ast).run(); }}},
+		{"ExpressionJoiner", {[&]() { ExpressionJoiner::run(ast); }}},
+		{"ExpressionSimplifier", {
+			[&]() { ExpressionSimplifier::run(_dialect, ast); },
+			[&](Block& _block, NameDispenser&) { ExpressionSimplifier::run(_dialect, _block); }
+		}},
+		{"ExpressionSplitter", {
+			[&]() { ExpressionSplitter{_dialect, *dispenser}(ast); },
+			[&](Block& _block, NameDispenser& _dispenser) { ExpressionSplitter{_dialect, _dispenser}(_block); }
+		}},
+		{"ForLoopConditionIntoBody", {[&]() { ForLoopConditionIntoBody{_dialect}(ast); }}},
+		{"ForLoopInitRewriter", {[&]() { ForLoopInitRewriter{}(ast); }}},
+		{"FullInliner", {[&]() { FullInliner{ast, *dispenser}.run(); }}},
+		{"FunctionGrouper", {[&]() { FunctionGrouper{}(ast); }}},
+		{"FunctionHoister", {[&]() { FunctionHoister{}(ast); }}},
+		{"LiteralRematerialiser", {[&]() { LiteralRematerialiser{_dialect}(ast); }}},
+		{"LoadResolver", {
+			[&]() { LoadResolver::run(_dialect, ast); },
+			[&](Block& _block, NameDispenser&) { LoadResolver::run(_dialect, _block, functionSideEffects, optimizeMLoad); },
+			[&]() {
+				functionSideEffects = SideEffectsPropagator::sideEffects(_dialect, CallGraphGenerator::callGraph(ast));
+				optimizeMLoad = !MSizeFinder::containsMSize(_dialect, ast);
+			}
+		}},
+		{"RedundantAssignEliminator", {
+			[&]() { RedundantAssignEliminator::run(_dialect, ast); },
+			[&](Block& _block, NameDispenser&) { RedundantAssignEliminator::run(_dialect, _block); }
+		}},
+		{"Rematerialiser", {[&]() { Rematerialiser::run(_dialect, ast); }}},
+		{"SSAReverser", {
+			[&]() { SSAReverser::run(ast); },
+			[&](Block& _block, NameDispenser&) { SSAReverser::run(_block); }
+		}},
+		{"SSATransform", {
+			[&]() { SSATransform::run(ast, *dispenser); },
+			[&](Block& _block, NameDispenser& _dispenser) { SSATransform::run(_block, _dispenser); }
+		}},
+		{"StackCompressor", {[&]() {
+			// We ignore the return value because we will get a much better error
+			// message once we perform code generation.
+			StackCompressor::run(
+				_dialect,
+				_object,
+				_optimizeStackAllocation,
+				stackCompressorMaxIterations
+			);
+		}}},
+		{"StructuralSimplifier", {[&]() { StructuralSimplifier{}(ast); }}},
+		{"UnusedPruner", {[&]() { UnusedPruner::runUntilStabilisedOnFullAST(_dialect, ast, reservedIdentifiers); }}},
+		{"VarDeclInitializer", {[&]() { VarDeclInitializer{}(ast); }}},
+		{"VarNameCleaner", {[&]() { VarNameCleaner{ast, _dialect, reservedIdentifiers}(ast); }}}
+	}, ast, dispenser, _threads, _statistics);
+
+	runner.runSequence({
+		"VarDeclInitializer",
+		"FunctionHoister",
+		"BlockFlattener",
+		"ForLoopInitRewriter",
+		"DeadCodeEliminator",
+		"FunctionGrouper",
+		"EquivalentFunctionCombiner",
+		"UnusedPruner",
+		"BlockFlattener",
+		"ControlFlowSimplifier",
+		"LiteralRematerialiser",
+		"StructuralSimplifier",
+		"ControlFlowSimplifier",
+		"ForLoopConditionIntoBody",
+		"BlockFlattener"
+	});
+
+	// None of the above can make stack problems worse.
+
+	dispenser = make_unique<NameDispenser>(_dialect, ast, reservedIdentifiers);
+
+	vector<pair<string, vector<string>>> const groups{
+		{"Turn into SSA and simplify", {
+			"ExpressionSplitter",
+			"SSATransform",
+			"RedundantAssignEliminator",
+			"RedundantAssignEliminator",
+			"ExpressionSimplifier",
+			"CommonSubexpressionEliminator",
+			"LoadResolver"
+		}},
+		{"Structural simplification in SSA", {
+			"ControlFlowSimplifier",
+			"LiteralRematerialiser",
+			"StructuralSimplifier",
+			"ControlFlowSimplifier",
+			"BlockFlattener",
+			"DeadCodeEliminator",
+			"UnusedPruner"
+		}},
+		{"Simplify again", {
+			"LoadResolver",
+			"CommonSubexpressionEliminator",
+			"UnusedPruner"
+		}},
+		{"Reverse SSA", {
+			"SSAReverser",
+			"CommonSubexpressionEliminator",
+			"UnusedPruner",
+			"ExpressionJoiner",
+			"ExpressionJoiner"
+		}},
+		// should have good "compilability" property here.
+		{"Functional expression inliner", {
+			"ExpressionInliner",
+			"UnusedPruner"
+		}},
+		{"Turn into SSA again and simplify", {
+			"ExpressionSplitter",
+			"SSATransform",
+			"RedundantAssignEliminator",
+			"RedundantAssignEliminator",
+			"CommonSubexpressionEliminator",
+			"LoadResolver"
+		}},
+		{"Full inliner", {
+			"FunctionGrouper",
+			"EquivalentFunctionCombiner",
+			"FullInliner",
+			"BlockFlattener"
+		}},
+		{"SSA plus simplify", {
+			"SSATransform",
+			"RedundantAssignEliminator",
+			"RedundantAssignEliminator",
+			"LoadResolver",
+			"ExpressionSimplifier",
+			"LiteralRematerialiser",
+			"StructuralSimplifier",
+			"BlockFlattener",
+			"DeadCodeEliminator",
+			"ControlFlowSimplifier",
+			"CommonSubexpressionEliminator",
+			"SSATransform",
+			"RedundantAssignEliminator",
+			"RedundantAssignEliminator",
+			"UnusedPruner",
+			"CommonSubexpressionEliminator"
+		}}
+	};
+
+	// Repeat until a fixed point is reached. The limit just prevents infinite loops.
+	for (size_t rounds = 0; rounds < 12; ++rounds)
+	{
+		uint64_t hashBefore = runner.hash();
+		for (auto const& group: groups)
+			runner.runGroup(group.first, group.second);
+		if (_statistics)
+			_statistics->rounds++;
+		if (runner.hash() == hashBefore)
+			break;
+	}
+
+	// Make source short and pretty.
+
+	runner.runSequence({
+		"ExpressionJoiner",
+		"Rematerialiser",
+		"UnusedPruner",
+		"ExpressionJoiner",
+		"UnusedPruner",
+		"ExpressionJoiner",
+		"UnusedPruner",
+
+		"SSAReverser",
+		"CommonSubexpressionEliminator",
+		"UnusedPruner",
+
+		"ExpressionJoiner",
+		"Rematerialiser",
+		"UnusedPruner",
+
+		"FunctionGrouper",
+		"StackCompressor",
+		"BlockFlattener",
+		"DeadCodeEliminator",
+		"ControlFlowSimplifier",
+
+		"FunctionGrouper"
+	});
 
 	if (EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&_dialect))
 	{
@@ -247,7 +499,7 @@ void OptimiserSuite::run(
 		if (ast.statements.size() > 1 && boost::get<Block>(ast.statements.front()).statements.empty())
 			ast.statements.erase(ast.statements.begin());
 	}
-	VarNameCleaner{ast, _dialect, reservedIdentifiers}(ast);
+	runner.runSequence({"VarNameCleaner"});
 
 	*_object.analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
 }
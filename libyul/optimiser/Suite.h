@@ -24,7 +24,10 @@
 #include <libyul/YulString.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <chrono>
+#include <map>
 #include <set>
+#include <string>
 
 namespace yul
 {
@@ -34,9 +37,42 @@ struct Dialect;
 class GasMeter;
 struct Object;
 
+/**
+ * Statistics collected by the optimiser suite across all its runs: how often each step
+ * was run, how often it changed the code and how much time it took, as well as how many
+ * groups of steps were skipped because they could not change the code.
+ */
+struct OptimiserStatistics
+{
+	struct Step
+	{
+		size_t runs = 0;
+		size_t changes = 0;
+		std::chrono::steady_clock::duration time{0};
+	};
+
+	std::map<std::string, Step> steps;
+	size_t rounds = 0;
+	size_t groupsRun = 0;
+	size_t groupsSkipped = 0;
+
+	/// @returns a human-readable table of the statistics.
+	std::string toString() const;
+};
+
 /**
  * Optimiser suite that combines all steps and also provides the settings for the heuristics.
  * Only optimizes the code of the provided object, does not descend into the sub-objects.
+ *
+ * The main part of the suite consists of groups of steps that are repeated until the code
+ * does not change anymore. Changes are detected by comparing hashes of the code, and a group
+ * is skipped if the code did not change since it was last run without effect.
+ *
+ * Steps that only look at a single function at a time are applied to the main block and to
+ * each function separately, concurrently if @a _threads is larger than one. Steps that look at
+ * multiple functions, like the inliners and the unused pruner, wait for the previous steps to
+ * finish. New names only depend on the position of the function they are chosen in, so the
+ * result does not depend on the number of threads.
  */
 class OptimiserSuite
 {
@@ -46,7 +82,9 @@ public:
 		GasMeter const* _meter,
 		Object& _object,
 		bool _optimizeStackAllocation,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		OptimiserStatistics* _statistics = nullptr,
+		size_t _threads = 1
 	);
 };
 
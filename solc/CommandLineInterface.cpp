@@ -33,6 +33,8 @@
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/GasEstimator.h>
+#include <libsolidity/formal/SMTQueryCache.h>
+#include <libsolidity/codegen/InlineAssemblyCache.h>
 
 #include <libyul/AssemblyStack.h>
 
@@ -48,12 +50,14 @@
 #include <libdevcore/CommonData.h>
 #include <libdevcore/CommonIO.h>
 #include <libdevcore/JSON.h>
+#include <libdevcore/ThreadPool.h>
 
 #include <memory>
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/asio.hpp>
 
 #ifdef _WIN32 // windows
 	#include <io.h>
@@ -109,6 +113,7 @@ static string const g_strAstJson = "ast-json";
 static string const g_strAstCompactJson = "ast-compact-json";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
+static string const g_strCacheDir = "cache-dir";
 static string const g_strCombinedJson = "combined-json";
 static string const g_strCompactJSON = "compact-format";
 static string const g_strContracts = "contracts";
@@ -119,8 +124,10 @@ static string const g_strEVMVersion = "evm-version";
 static string const g_streWasm = "ewasm";
 static string const g_strGas = "gas";
 static string const g_strHelp = "help";
+static string const g_strInlineAssemblyCacheStats = "inline-assembly-cache-stats";
 static string const g_strInputFile = "input-file";
 static string const g_strInterface = "interface";
+static string const g_strJobs = "jobs";
 static string const g_strYul = "yul";
 static string const g_strIR = "ir";
 static string const g_strEWasm = "ewasm";
@@ -136,6 +143,7 @@ static string const g_strOpcodes = "opcodes";
 static string const g_strOptimize = "optimize";
 static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOptimizeYul = "optimize-yul";
+static string const g_strYulOptimizerStats = "yul-optimizer-stats";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
 static string const g_strSignatureHashes = "hashes";
@@ -143,6 +151,12 @@ static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
 static string const g_strSrcMap = "srcmap";
 static string const g_strSrcMapRuntime = "srcmap-runtime";
+static string const g_strServer = "server";
+static string const g_strServerSocket = "server-socket";
+static string const g_strSMTCacheDir = "smt-cache-dir";
+static string const g_strSMTCacheStats = "smt-cache-stats";
+static string const g_strSMTSolver = "smt-solver";
+static string const g_strSMTWaitForAllSolvers = "smt-wait-for-all-solvers";
 static string const g_strStandardJSON = "standard-json";
 static string const g_strStrictAssembly = "strict-assembly";
 static string const g_strPrettyJson = "pretty-json";
@@ -163,12 +177,15 @@ static string const g_argAstCompactJson = g_strAstCompactJson;
 static string const g_argAstJson = g_strAstJson;
 static string const g_argBinary = g_strBinary;
 static string const g_argBinaryRuntime = g_strBinaryRuntime;
+static string const g_argCacheDir = g_strCacheDir;
 static string const g_argCombinedJson = g_strCombinedJson;
 static string const g_argCompactJSON = g_strCompactJSON;
 static string const g_argErrorRecovery = g_strErrorRecovery;
 static string const g_argGas = g_strGas;
 static string const g_argHelp = g_strHelp;
+static string const g_argInlineAssemblyCacheStats = g_strInlineAssemblyCacheStats;
 static string const g_argInputFile = g_strInputFile;
+static string const g_argJobs = g_strJobs;
 static string const g_argYul = g_strYul;
 static string const g_argIR = g_strIR;
 static string const g_argEWasm = g_strEWasm;
@@ -182,8 +199,15 @@ static string const g_argNatspecUser = g_strNatspecUser;
 static string const g_argOpcodes = g_strOpcodes;
 static string const g_argOptimize = g_strOptimize;
 static string const g_argOptimizeRuns = g_strOptimizeRuns;
+static string const g_argYulOptimizerStats = g_strYulOptimizerStats;
 static string const g_argOutputDir = g_strOutputDir;
 static string const g_argSignatureHashes = g_strSignatureHashes;
+static string const g_argServer = g_strServer;
+static string const g_argServerSocket = g_strServerSocket;
+static string const g_argSMTCacheDir = g_strSMTCacheDir;
+static string const g_argSMTCacheStats = g_strSMTCacheStats;
+static string const g_argSMTSolver = g_strSMTSolver;
+static string const g_argSMTWaitForAllSolvers = g_strSMTWaitForAllSolvers;
 static string const g_argStandardJSON = g_strStandardJSON;
 static string const g_argStrictAssembly = g_strStrictAssembly;
 static string const g_argVersion = g_strVersion;
@@ -651,6 +675,50 @@ Allowed options)",
 			"Lower values will optimize more for initial deployment cost, higher values will optimize more for high-frequency usage."
 		)
 		(g_strOptimizeYul.c_str(), "Enable Yul optimizer in Solidity, mostly for ABIEncoderV2. Still considered experimental.")
+		(
+			g_argYulOptimizerStats.c_str(),
+			"Used together with --strict-assembly and --optimize: Output how often each step of the Yul optimizer "
+			"was run, how often it changed the code and the time spent in it."
+		)
+		(
+			g_argInlineAssemblyCacheStats.c_str(),
+			"Output how often the code generator re-used already parsed, analysed and optimised assembly snippets "
+			"and how much time this saved."
+		)
+		(
+			(g_argJobs + ",j").c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Compile up to n contracts concurrently and let the SMTChecker query up to n solvers concurrently. "
+			"In strict assembly mode, optimize up to n functions concurrently. "
+			"The generated code does not depend on this setting. Zero uses the number of hardware threads."
+		)
+		(
+			g_argCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Store the bytecode, assembly and source mappings of compiled contracts in the given directory "
+			"and re-use them if the sources and settings did not change. Not used together with --gas."
+		)
+		(
+			g_argSMTCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Store the answers of the SMT solvers used by the SMTChecker in the given directory "
+			"and re-use them for identical queries."
+		)
+		(
+			g_argSMTCacheStats.c_str(),
+			"Used together with --smt-cache-dir: Output how many SMT queries were answered from the cache."
+		)
+		(
+			g_argSMTSolver.c_str(),
+			po::value<string>()->value_name("command"),
+			"Let the SMTChecker query the given SMT-LIB2 solver binary, e.g. \"z3 -in\" or \"cvc4 --lang smt2 --incremental\". "
+			"The solver process is kept alive and queried incrementally."
+		)
+		(
+			g_argSMTWaitForAllSolvers.c_str(),
+			"Let the SMTChecker wait for the answers of all SMT solvers and report conflicting answers, "
+			"instead of using the answer of the first solver that answers."
+		)
 		(g_argPrettyJson.c_str(), "Output JSON in pretty format. Currently it only works with the combined JSON output.")
 		(
 			g_argLibraries.c_str(),
@@ -676,6 +744,19 @@ Allowed options)",
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input and provides the result on the standard output."
 		)
+		(
+			g_argServer.c_str(),
+			"Switch to Standard JSON server mode, ignoring all options except --allow-paths, --server-socket "
+			"and --smt-cache-dir. It reads one Standard JSON input per line from standard input and writes "
+			"the result as a single line to the standard output. Analysed sources and the answers of the "
+			"SMT solvers are kept between inputs."
+		)
+		(
+			g_argServerSocket.c_str(),
+			po::value<string>()->value_name("path"),
+			"Used together with --server: Accept connections on the Unix domain socket at the given path "
+			"instead of using standard input and output. Connections are served one after another."
+		)
 		(
 			g_argAssemble.c_str(),
 			"Switch to assembly mode, ignoring all options except --machine and --optimize and assumes input is assembly."
@@ -850,6 +931,9 @@ bool CommandLineInterface::processInput()
 		}
 	}
 
+	if (m_args.count(g_argServer))
+		return serve(fileReader);
+
 	if (m_args.count(g_argStandardJSON))
 	{
 		string input = dev::readStandardInput();
@@ -956,6 +1040,21 @@ bool CommandLineInterface::processInput()
 		settings.optimizeStackAllocation = settings.runYulOptimiser;
 		m_compiler->setOptimiserSettings(settings);
 
+		unsigned jobs = m_args[g_argJobs].as<unsigned>();
+		m_compiler->setParallelism(jobs == 0 ? ThreadPool::hardwareConcurrency() : jobs);
+		// Gas estimates need the assembly items, which are not cached.
+		if (m_args.count(g_argCacheDir) && !m_args.count(g_argGas))
+			m_compiler->setArtifactCacheDirectory(m_args[g_argCacheDir].as<string>());
+		shared_ptr<smt::SMTQueryCache> smtQueryCache;
+		if (m_args.count(g_argSMTCacheDir))
+		{
+			smtQueryCache = make_shared<smt::SMTQueryCache>(m_args[g_argSMTCacheDir].as<string>());
+			m_compiler->setSMTQueryCache(smtQueryCache);
+		}
+		if (m_args.count(g_argSMTSolver))
+			m_compiler->setSMTSolverCommand(m_args[g_argSMTSolver].as<string>());
+		m_compiler->setSMTWaitForAllSolvers(m_args.count(g_argSMTWaitForAllSolvers));
+
 		bool successful = m_compiler->compile();
 
 		for (auto const& error: m_compiler->errors())
@@ -963,6 +1062,10 @@ bool CommandLineInterface::processInput()
 			g_hasOutput = true;
 			formatter->printErrorInformation(*error);
 		}
+		if (smtQueryCache && m_args.count(g_argSMTCacheStats))
+			serr() << "SMT query cache: " << smtQueryCache->hits() << " hits, " << smtQueryCache->misses() << " misses." << endl;
+		if (m_args.count(g_argInlineAssemblyCacheStats))
+			serr() << "Inline assembly cache: " << InlineAssemblyCache::instance().statistics().toString() << endl;
 
 		if (!successful)
 		{
@@ -1179,9 +1282,59 @@ void CommandLineInterface::handleAst(string const& _argStr)
 	}
 }
 
+bool CommandLineInterface::serve(ReadCallback::Callback const& _fileReader)
+{
+	StandardCompiler compiler(_fileReader);
+	compiler.enableAnalysisCache();
+	compiler.setSMTQueryCache(make_shared<smt::SMTQueryCache>(
+		m_args.count(g_argSMTCacheDir) ? m_args[g_argSMTCacheDir].as<string>() : string()
+	));
+
+	auto serveStream = [&](istream& _input, ostream& _output)
+	{
+		string line;
+		while (getline(_input, line))
+			if (!boost::trim_copy(line).empty())
+				_output << compiler.compile(line) << endl;
+	};
+
+	if (!m_args.count(g_argServerSocket))
+	{
+		serveStream(cin, sout());
+		return true;
+	}
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+	namespace local = boost::asio::local;
+	string const socketPath = m_args[g_argServerSocket].as<string>();
+	try
+	{
+		boost::asio::io_service ioService;
+		// Remove a stale socket of a previous server, but never any other kind of file.
+		if (boost::filesystem::status(socketPath).type() == boost::filesystem::socket_file)
+			boost::filesystem::remove(socketPath);
+		local::stream_protocol::acceptor acceptor(ioService, local::stream_protocol::endpoint(socketPath));
+		while (true)
+		{
+			local::stream_protocol::iostream connection;
+			acceptor.accept(*connection.rdbuf());
+			serveStream(connection, connection);
+		}
+	}
+	catch (boost::system::system_error const& _error)
+	{
+		serr() << "Unable to serve on " << socketPath << ": " << _error.what() << endl;
+		return false;
+	}
+#else
+	serr() << "Unix domain sockets are not supported on this platform." << endl;
+	return false;
+#endif
+}
+
 bool CommandLineInterface::actOnInput()
 {
-	if (m_args.count(g_argStandardJSON) || m_onlyAssemble)
+	if (m_args.count(g_argStandardJSON) || m_args.count(g_argServer) || m_onlyAssemble)
 		// Already done in "processInput" phase.
 		return true;
 	else if (m_onlyLink)
@@ -1299,7 +1452,13 @@ bool CommandLineInterface::assemble(
 			if (!stack.parseAndAnalyze(src.first, src.second))
 				successful = false;
 			else
+			{
+				unsigned jobs = m_args[g_argJobs].as<unsigned>();
+				stack.setParallelism(jobs == 0 ? ThreadPool::hardwareConcurrency() : jobs);
+				if (m_args.count(g_argYulOptimizerStats))
+					stack.enableOptimiserStatistics();
 				stack.optimize();
+			}
 		}
 		catch (Exception const& _exception)
 		{
@@ -1354,6 +1513,12 @@ bool CommandLineInterface::assemble(
 		sout() << endl << "Pretty printed source:" << endl;
 		sout() << stack.print() << endl;
 
+		if (yul::OptimiserStatistics const* statistics = stack.optimiserStatistics())
+		{
+			sout() << endl << "Optimizer statistics:" << endl;
+			sout() << statistics->toString() << endl;
+		}
+
 		yul::MachineAssemblyObject object;
 		try
 		{
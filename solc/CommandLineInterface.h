@@ -59,6 +59,10 @@ private:
 
 	bool assemble(yul::AssemblyStack::Language _language, yul::AssemblyStack::Machine _targetMachine, bool _optimize);
 
+	/// Compiles Standard JSON inputs, one per line, until the input is closed.
+	/// @returns false if the server could not be started.
+	bool serve(ReadCallback::Callback const& _fileReader);
+
 	void outputCompilationResults();
 
 	void handleCombinedJSON();
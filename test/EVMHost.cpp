@@ -85,8 +85,9 @@ EVMHost::EVMHost(langutil::EVMVersion _evmVersion, evmc::vm* _vm):
 
 evmc_storage_status EVMHost::set_storage(const evmc_address& _addr, const evmc_bytes32& _key, const evmc_bytes32& _value) noexcept
 {
-	evmc_bytes32 previousValue = m_state.accounts[_addr].storage[_key];
-	m_state.accounts[_addr].storage[_key] = _value;
+	evmc_bytes32& storedValue = writableAccount(_addr).storage[_key];
+	evmc_bytes32 previousValue = storedValue;
+	storedValue = _value;
 
 	// TODO EVMC_STORAGE_MODIFIED_AGAIN should be also used
 	if (previousValue == _value)
@@ -103,9 +104,9 @@ evmc_storage_status EVMHost::set_storage(const evmc_address& _addr, const evmc_b
 void EVMHost::selfdestruct(const evmc_address& _addr, const evmc_address& _beneficiary) noexcept
 {
 	// TODO actual selfdestruct is even more complicated.
-	evmc_uint256be balance = m_state.accounts[_addr].balance;
+	evmc_uint256be balance = createdAccount(_addr).balance;
 	m_state.accounts.erase(_addr);
-	m_state.accounts[_beneficiary].balance = balance;
+	writableAccount(_beneficiary).balance = balance;
 }
 
 evmc::result EVMHost::call(evmc_message const& _message) noexcept
@@ -130,7 +131,7 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 	State stateBackup = m_state;
 
 	u256 value{convertFromEVMC(_message.value)};
-	Account& sender = m_state.accounts[_message.sender];
+	Account& sender = writableAccount(_message.sender);
 
 	bytes code;
 
@@ -162,19 +163,19 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 	}
 	else if (message.kind == EVMC_DELEGATECALL)
 	{
-		code = m_state.accounts[message.destination].code;
+		code = createdAccount(message.destination).code;
 		message.destination = m_currentAddress;
 	}
 	else if (message.kind == EVMC_CALLCODE)
 	{
-		code = m_state.accounts[message.destination].code;
+		code = createdAccount(message.destination).code;
 		message.destination = m_currentAddress;
 	}
 	else
-		code = m_state.accounts[message.destination].code;
+		code = createdAccount(message.destination).code;
 	//TODO CREATE2
 
-	Account& destination = m_state.accounts[message.destination];
+	Account& destination = writableAccount(message.destination);
 
 	if (value != 0 && message.kind != EVMC_DELEGATECALL && message.kind != EVMC_CALLCODE)
 	{
@@ -198,9 +199,11 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 		}
 		else
 		{
+			// The execution may have copied the state, so the account is looked up again.
+			Account& contract = writableAccount(message.destination);
 			result.create_address = message.destination;
-			destination.code = bytes(result.output_data, result.output_data + result.output_size);
-			destination.codeHash = convertToEVMC(keccak256(destination.code));
+			contract.code = bytes(result.output_data, result.output_data + result.output_size);
+			contract.codeHash = convertToEVMC(keccak256(contract.code));
 		}
 	}
 
@@ -302,8 +305,8 @@ evmc::result EVMHost::precompileECRecover(evmc_message const& _message) noexcept
 
 evmc::result EVMHost::precompileSha256(evmc_message const& _message) noexcept
 {
-	// static data so that we do not need a release routine...
-	bytes static hash;
+	// per-thread static data so that we do not need a release routine...
+	thread_local bytes hash;
 	hash = picosha2::hash256(bytes(
 		_message.input_data,
 		_message.input_data + _message.input_size
@@ -384,8 +387,8 @@ evmc::result EVMHost::precompileRipeMD160(evmc_message const& _message) noexcept
 
 evmc::result EVMHost::precompileIdentity(evmc_message const& _message) noexcept
 {
-	// static data so that we do not need a release routine...
-	bytes static data;
+	// per-thread static data so that we do not need a release routine...
+	thread_local bytes data;
 	data = bytes(_message.input_data, _message.input_data + _message.input_size);
 	evmc::result result({});
 	result.gas_left = _message.gas;
@@ -27,8 +27,15 @@
 
 #include <liblangutil/EVMVersion.h>
 
+#include <libdevcore/Assertions.h>
+#include <libdevcore/Exceptions.h>
 #include <libdevcore/FixedHash.h>
 
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 namespace dev
 {
 namespace test
@@ -51,7 +58,7 @@ public:
 		size_t nonce = 0;
 		bytes code;
 		evmc_bytes32 codeHash = {};
-		std::map<evmc_bytes32, evmc_bytes32> storage;
+		std::unordered_map<evmc_bytes32, evmc_bytes32> storage;
 	};
 
 	struct LogEntry
@@ -61,25 +68,65 @@ public:
 		bytes data;
 	};
 
+	/// The state of the chain. Copies of the state share their accounts, which are only
+	/// copied when they are modified through writableAccount, so copying the state is cheap.
 	struct State
 	{
 		size_t blockNumber;
 		uint64_t timestamp;
-		std::map<evmc_address, Account> accounts;
+		std::map<evmc_address, std::shared_ptr<Account>> accounts;
 		std::vector<LogEntry> logs;
 	};
 
-	Account* account(evmc_address const& _address)
+	/// @returns the account at @a _address or nullptr if it does not exist.
+	Account const* account(evmc_address const& _address)
 	{
+		auto it = m_state.accounts.find(_address);
 		// Make all precompiled contracts exist.
 		// Be future-proof and consider everything below 1024 as precompiled contract.
-		if (u160(convertFromEVMC(_address)) < 1024)
-			m_state.accounts[_address];
-		auto it = m_state.accounts.find(_address);
-		return it == m_state.accounts.end() ? nullptr : &it->second;
+		if (it == m_state.accounts.end() && u160(convertFromEVMC(_address)) < 1024)
+			it = m_state.accounts.emplace(_address, std::make_shared<Account>()).first;
+		return it == m_state.accounts.end() ? nullptr : it->second.get();
+	}
+
+	/// @returns the account at @a _address and creates it if it does not exist.
+	Account const& createdAccount(evmc_address const& _address)
+	{
+		std::shared_ptr<Account>& account = m_state.accounts[_address];
+		if (!account)
+			account = std::make_shared<Account>();
+		return *account;
 	}
 
-	void reset() { m_state = State{}; m_currentAddress = {}; }
+	/// @returns the account at @a _address for modification and creates it if it does not exist.
+	/// If the account is shared with another copy of the state, it is copied first.
+	/// The reference is invalidated by the next copy of the state.
+	Account& writableAccount(evmc_address const& _address)
+	{
+		std::shared_ptr<Account>& account = m_state.accounts[_address];
+		if (!account)
+			account = std::make_shared<Account>();
+		else if (account.use_count() > 1)
+			account = std::make_shared<Account>(*account);
+		return *account;
+	}
+
+	/// Stores the current state and @returns an id that restores it when passed to revert.
+	size_t snapshot()
+	{
+		m_snapshots.push_back(m_state);
+		return m_snapshots.size() - 1;
+	}
+	/// Restores the state of the snapshot @a _id and discards all later snapshots.
+	/// The snapshot itself is kept, so the state can be restored again.
+	void revert(size_t _id)
+	{
+		assertThrow(_id < m_snapshots.size(), Exception, "Invalid snapshot.");
+		m_snapshots.resize(_id + 1);
+		m_state = m_snapshots.back();
+	}
+
+	void reset() { m_state = State{}; m_snapshots.clear(); m_currentAddress = {}; }
 	void newBlock()
 	{
 		m_state.blockNumber++;
@@ -94,8 +141,12 @@ public:
 
 	evmc_bytes32 get_storage(evmc_address const& _addr, evmc_bytes32 const& _key) noexcept final
 	{
-		if (Account* acc = account(_addr))
-			return acc->storage[_key];
+		if (Account const* acc = account(_addr))
+		{
+			auto it = acc->storage.find(_key);
+			if (it != acc->storage.end())
+				return it->second;
+		}
 		return {};
 	}
 
@@ -182,6 +233,7 @@ private:
 
 	evmc::vm* m_vm = nullptr;
 	evmc_revision m_evmVersion;
+	std::vector<State> m_snapshots;
 };
 
 
@@ -0,0 +1,224 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Tests for the state handling of the EVM execution host.
+ */
+
+#include <test/EVMHost.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+
+namespace
+{
+
+/// Executes "code" of the form [value, callee, fail]: Stores value at slot zero of the
+/// current account, calls the account at address callee with one wei if callee is not zero
+/// and reverts if fail is not zero.
+evmc_result executeScript(
+	evmc_instance*,
+	evmc_context* _context,
+	evmc_revision,
+	evmc_message const* _message,
+	uint8_t const* _code,
+	size_t _codeSize
+)
+{
+	EVMHost& host = static_cast<EVMHost&>(static_cast<evmc::Host&>(*_context));
+	evmc_result result = {};
+	result.status_code = EVMC_SUCCESS;
+	result.gas_left = _message->gas;
+	if (_codeSize < 3)
+		return result;
+
+	host.set_storage(_message->destination, {}, EVMHost::convertToEVMC(h256(_code[0])));
+	if (_code[1] != 0)
+	{
+		evmc_message message = {};
+		message.kind = EVMC_CALL;
+		message.depth = _message->depth + 1;
+		message.gas = _message->gas;
+		message.sender = _message->destination;
+		message.destination = EVMHost::convertToEVMC(Address(_code[1]));
+		message.value = EVMHost::convertToEVMC(h256(1));
+		evmc::result nested = host.call(message);
+		result.gas_left = nested.gas_left;
+	}
+	if (_code[2] != 0)
+		result.status_code = EVMC_REVERT;
+	return result;
+}
+
+evmc::vm* scriptVM()
+{
+	static evmc_instance instance = {
+		EVMC_ABI_VERSION,
+		"script",
+		"0",
+		[](evmc_instance*) {},
+		executeScript,
+		nullptr,
+		nullptr,
+		nullptr
+	};
+	static evmc::vm vm(&instance);
+	return &vm;
+}
+
+evmc_address const sender = EVMHost::convertToEVMC(Address(0x1000));
+evmc_address const caller = EVMHost::convertToEVMC(Address(0x2000));
+evmc_address const callee = EVMHost::convertToEVMC(Address(0x30));
+
+class EVMHostFramework
+{
+public:
+	EVMHostFramework(): host(langutil::EVMVersion{}, scriptVM())
+	{
+		host.writableAccount(sender).balance = EVMHost::convertToEVMC(h256(1000));
+	}
+
+	/// Sends @a _value wei from the sender to the caller, which runs @a _code.
+	evmc_status_code callCaller(bytes const& _code, uint64_t _value = 10)
+	{
+		host.writableAccount(caller).code = _code;
+		evmc_message message = {};
+		message.kind = EVMC_CALL;
+		message.gas = 100000;
+		message.sender = sender;
+		message.destination = caller;
+		message.value = EVMHost::convertToEVMC(h256(_value));
+		return host.call(message).status_code;
+	}
+
+	u256 balance(evmc_address const& _address)
+	{
+		return u256(EVMHost::convertFromEVMC(host.get_balance(_address)));
+	}
+
+	u256 storage(evmc_address const& _address)
+	{
+		return u256(EVMHost::convertFromEVMC(host.get_storage(_address, {})));
+	}
+
+	static u256 storage(EVMHost::State const& _state, evmc_address const& _address)
+	{
+		auto account = _state.accounts.find(_address);
+		if (account == _state.accounts.end() || !account->second->storage.count({}))
+			return 0;
+		return u256(EVMHost::convertFromEVMC(account->second->storage.at({})));
+	}
+
+	EVMHost host;
+};
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(EVMHostState, EVMHostFramework)
+
+BOOST_AUTO_TEST_CASE(snapshot_revert_round_trip)
+{
+	BOOST_REQUIRE_EQUAL(callCaller(bytes{1, 0, 0}), EVMC_SUCCESS);
+	size_t const first = host.snapshot();
+	BOOST_REQUIRE_EQUAL(callCaller(bytes{2, 0, 0}), EVMC_SUCCESS);
+	size_t const second = host.snapshot();
+	BOOST_REQUIRE_EQUAL(callCaller(bytes{3, 0, 0}), EVMC_SUCCESS);
+	BOOST_CHECK_EQUAL(storage(caller), 3);
+	BOOST_CHECK_EQUAL(balance(caller), 30);
+
+	host.revert(second);
+	BOOST_CHECK_EQUAL(storage(caller), 2);
+	BOOST_CHECK_EQUAL(balance(caller), 20);
+
+	// Snapshots can be restored more than once.
+	BOOST_REQUIRE_EQUAL(callCaller(bytes{4, 0, 0}), EVMC_SUCCESS);
+	host.revert(second);
+	BOOST_CHECK_EQUAL(storage(caller), 2);
+	BOOST_CHECK_EQUAL(balance(caller), 20);
+
+	host.revert(first);
+	BOOST_CHECK_EQUAL(storage(caller), 1);
+	BOOST_CHECK_EQUAL(balance(caller), 10);
+	BOOST_CHECK_EQUAL(balance(sender), 990);
+
+	// Restoring an earlier snapshot discards the later ones.
+	BOOST_CHECK_THROW(host.revert(second), Exception);
+	host.reset();
+	BOOST_CHECK_THROW(host.revert(first), Exception);
+}
+
+BOOST_AUTO_TEST_CASE(failed_nested_call_is_rolled_back)
+{
+	host.writableAccount(callee).code = bytes{7, 0, 1};
+	host.writableAccount(callee).balance = EVMHost::convertToEVMC(h256(5));
+	EVMHost::State const copy = host.m_state;
+
+	BOOST_REQUIRE_EQUAL(callCaller(bytes{1, 0x30, 0}), EVMC_SUCCESS);
+	// The writes of the caller are kept, the storage and balance writes of the callee are not.
+	BOOST_CHECK_EQUAL(storage(caller), 1);
+	BOOST_CHECK_EQUAL(balance(caller), 10);
+	BOOST_CHECK_EQUAL(storage(callee), 0);
+	BOOST_CHECK_EQUAL(balance(callee), 5);
+	BOOST_CHECK_EQUAL(balance(sender), 990);
+
+	// The copy still shares the unmodified callee, but not the modified accounts.
+	BOOST_CHECK(copy.accounts.at(callee) == host.m_state.accounts.at(callee));
+	BOOST_CHECK(copy.accounts.at(sender) != host.m_state.accounts.at(sender));
+	BOOST_CHECK_EQUAL(u256(EVMHost::convertFromEVMC(copy.accounts.at(sender)->balance)), 1000);
+	BOOST_CHECK_EQUAL(storage(copy, caller), 0);
+}
+
+BOOST_AUTO_TEST_CASE(successful_nested_call_leaves_copies_untouched)
+{
+	host.writableAccount(callee).code = bytes{7, 0, 0};
+	size_t const initial = host.snapshot();
+	EVMHost::State const copy = host.m_state;
+
+	BOOST_REQUIRE_EQUAL(callCaller(bytes{1, 0x30, 0}), EVMC_SUCCESS);
+	BOOST_CHECK_EQUAL(storage(caller), 1);
+	BOOST_CHECK_EQUAL(balance(caller), 9);
+	BOOST_CHECK_EQUAL(storage(callee), 7);
+	BOOST_CHECK_EQUAL(balance(callee), 1);
+
+	BOOST_CHECK_EQUAL(storage(copy, callee), 0);
+	BOOST_CHECK_EQUAL(u256(EVMHost::convertFromEVMC(copy.accounts.at(callee)->balance)), 0);
+	host.revert(initial);
+	BOOST_CHECK_EQUAL(storage(callee), 0);
+	BOOST_CHECK_EQUAL(balance(callee), 0);
+	BOOST_CHECK_EQUAL(balance(sender), 1000);
+}
+
+BOOST_AUTO_TEST_CASE(failed_outer_call_is_rolled_back)
+{
+	host.writableAccount(callee).code = bytes{7, 0, 0};
+	BOOST_CHECK_EQUAL(callCaller(bytes{1, 0x30, 1}), EVMC_REVERT);
+	BOOST_CHECK_EQUAL(storage(caller), 0);
+	BOOST_CHECK_EQUAL(balance(caller), 0);
+	BOOST_CHECK_EQUAL(storage(callee), 0);
+	BOOST_CHECK_EQUAL(balance(callee), 0);
+	BOOST_CHECK_EQUAL(balance(sender), 1000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+} // end namespaces
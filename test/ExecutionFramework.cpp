@@ -57,7 +57,7 @@ ExecutionFramework::ExecutionFramework(langutil::EVMVersion _evmVersion):
 	m_evmHost->reset();
 
 	for (size_t i = 0; i < 10; i++)
-		m_evmHost->m_state.accounts[EVMHost::convertToEVMC(account(i))].balance =
+		m_evmHost->writableAccount(EVMHost::convertToEVMC(account(i))).balance =
 			EVMHost::convertToEVMC(u256(1) << 100);
 
 }
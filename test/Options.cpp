@@ -54,7 +54,8 @@ Options::Options()
 		("optimize", po::bool_switch(&optimize), "enables optimization")
 		("optimize-yul", po::bool_switch(&optimizeYul), "enables Yul optimization")
 		("abiencoderv2", po::bool_switch(&useABIEncoderV2), "enables abi encoder v2")
-		("show-messages", po::bool_switch(&showMessages), "enables message output");
+		("show-messages", po::bool_switch(&showMessages), "enables message output")
+		("show-compilation-cache-stats", po::bool_switch(&showCompilationCacheStatistics), "prints the hit rate of the cache of compiled contracts at exit");
 
 	parse(suite.argc, suite.argv);
 }
@@ -36,6 +36,7 @@ struct Options: CommonOptions
 {
 	bool showMessages = false;
 	bool useABIEncoderV2 = false;
+	bool showCompilationCacheStatistics = false;
 
 	static Options const& get();
 
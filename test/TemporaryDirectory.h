@@ -0,0 +1,53 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Temporary directory for tests that write files.
+ */
+
+#pragma once
+
+#include <boost/filesystem/path.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <string>
+
+namespace dev
+{
+namespace test
+{
+
+/**
+ * Reserves a new path in the temporary directory of the system and removes the directory
+ * at that path together with its contents on destruction. The directory itself is not created.
+ */
+class TemporaryDirectory: boost::noncopyable
+{
+public:
+	/// @param _prefix start of the name of the directory, which ends with a random suffix.
+	explicit TemporaryDirectory(std::string const& _prefix = "solc");
+	~TemporaryDirectory();
+
+	boost::filesystem::path const& path() const { return m_path; }
+	/// @returns the number of entries directly below the directory, zero if it does not exist.
+	size_t fileCount() const;
+
+private:
+	boost::filesystem::path m_path;
+};
+
+}
+}
@@ -194,6 +194,22 @@ BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 	BOOST_CHECK_EQUAL(m.render(), templ);
 }
 
+BOOST_AUTO_TEST_CASE(unclosed_tags_rendered)
+{
+	string templ = "<?c>x<#l>y</c><a>";
+	string result = Whiskers(templ)("c", true)("a", "A").render();
+	BOOST_CHECK_EQUAL(result, "x<#l>yA");
+}
+
+BOOST_AUTO_TEST_CASE(same_template_different_values)
+{
+	// The parsed template is shared, the values are not.
+	string templ = "<?c><a><!c>-</c>";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", true)("a", "A").render(), "A");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", true)("a", "B").render(), "B");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", false).render(), "-");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -1158,6 +1158,60 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(parallel_optimisation)
+{
+	auto createAssembly = []()
+	{
+		AssemblyPointer main = make_shared<Assembly>();
+		for (size_t i = 0; i < 3; ++i)
+		{
+			AssemblyPointer sub = make_shared<Assembly>();
+			for (size_t j = 0; j < 20; ++j)
+			{
+				auto tag = sub->newTag();
+				sub->append(tag);
+				sub->append(u256(j));
+				sub->append(u256(2));
+				sub->append(Instruction::ADD);
+				sub->append(Instruction::CALLDATALOAD);
+				sub->append(Instruction::DUP1);
+				sub->append(Instruction::ADD);
+				sub->append(tag.pushTag());
+				sub->append(Instruction::JUMPI);
+			}
+			size_t subId = size_t(main->appendSubroutine(sub).data());
+			main->append(AssemblyItem(Tag, 1).toSubAssemblyTag(subId).pushTag());
+			main->append(u256(i));
+			main->append(u256(3));
+			main->append(Instruction::MUL);
+			main->append(Instruction::SSTORE);
+		}
+		return main;
+	};
+
+	Assembly::OptimiserSettings settings;
+	settings.isCreation = true;
+	settings.runJumpdestRemover = true;
+	settings.runPeephole = true;
+	settings.runDeduplicate = true;
+	settings.runCSE = true;
+	settings.runConstantOptimiser = true;
+	settings.evmVersion = dev::test::Options::get().evmVersion();
+
+	AssemblyPointer serial = createAssembly();
+	string const unoptimised = serial->assemblyString();
+	serial->optimise(settings);
+	BOOST_CHECK(serial->assemblyString() != unoptimised);
+
+	for (unsigned parallelism: {2u, 8u})
+	{
+		settings.parallelism = parallelism;
+		AssemblyPointer parallel = createAssembly();
+		parallel->optimise(settings);
+		BOOST_CHECK_EQUAL(parallel->assemblyString(), serial->assemblyString());
+	}
+}
+
 BOOST_AUTO_TEST_CASE(cse_sub_zero)
 {
 	checkCSE({
@@ -25,6 +25,8 @@
 
 #include <test/Options.h>
 
+#include <algorithm>
+
 namespace langutil
 {
 namespace test
@@ -47,6 +49,41 @@ BOOST_AUTO_TEST_CASE(test_fail)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(line_column_and_line_at_position)
+{
+	for (std::string const source: {"", "\n", "a", "ab\ncd", "\n\nab\n", "ab\n\ncd\n\n", "a\nbc\ndef"})
+	{
+		CharStream stream(source, "source");
+		// Positions past the end are treated like the end of the source.
+		for (int position = 0; position <= int(source.size()) + 1; ++position)
+		{
+			size_t end = std::min<size_t>(position, source.size());
+			int line = std::count(source.begin(), source.begin() + end, '\n');
+			size_t lineStart = end == 0 ? 0 : source.rfind('\n', end - 1);
+			lineStart = (end == 0 || lineStart == std::string::npos) ? 0 : lineStart + 1;
+			BOOST_CHECK(stream.translatePositionToLineColumn(position) == std::make_tuple(line, int(end - lineStart)));
+
+			// A position on a newline refers to the line before the newline.
+			size_t searchStart = end > 0 ? end - 1 : 0;
+			lineStart = source.rfind('\n', searchStart);
+			lineStart = lineStart == std::string::npos ? 0 : lineStart + 1;
+			BOOST_CHECK_EQUAL(
+				stream.lineAtPosition(position),
+				source.substr(lineStart, std::min(source.find('\n', lineStart), source.size()) - lineStart)
+			);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(copies_share_line_index)
+{
+	CharStream stream("a\nbc\ndef", "source");
+	BOOST_CHECK(stream.translatePositionToLineColumn(3) == std::make_tuple(1, 1));
+	CharStream copy = stream;
+	BOOST_CHECK(copy.translatePositionToLineColumn(6) == std::make_tuple(2, 1));
+	BOOST_CHECK_EQUAL(copy.lineAtPosition(7), "def");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
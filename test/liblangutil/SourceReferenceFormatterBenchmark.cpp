@@ -0,0 +1,71 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Benchmark of the formatting of errors in a large source file, which is dominated by the
+ * translation of source positions into lines and columns.
+ * It is disabled by default, run it with
+ * soltest -t SourceReferenceFormatterBenchmark
+ */
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/Exceptions.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <test/Options.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace std;
+
+namespace langutil
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(SourceReferenceFormatterBenchmark, *boost::unit_test::disabled())
+
+BOOST_AUTO_TEST_CASE(format_errors_in_large_file)
+{
+	size_t const lines = 50000;
+	size_t const errors = 10000;
+
+	// Similar to a flattened file with many contracts.
+	string source;
+	for (size_t i = 0; i < lines; ++i)
+		source += "\t\tuint256 variable" + to_string(i) + " = someFunction(" + to_string(i) + ");\n";
+	auto stream = make_shared<CharStream>(source, "flattened.sol");
+
+	auto start = chrono::steady_clock::now();
+	size_t outputSize = 0;
+	for (size_t i = 0; i < errors; ++i)
+	{
+		int position = int(source.size() / errors * i);
+		Error error(Error::Type::TypeError, SourceLocation{position, position + 10, stream}, "Benchmark error.");
+		outputSize += SourceReferenceFormatter::formatErrorInformation(error).size();
+	}
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+	cout <<
+		"Formatted " << errors << " errors (" << outputSize << " bytes) in a file with " << lines <<
+		" lines in " << elapsed.count() << "s: " << size_t(errors / elapsed.count()) << " errors/s" << endl;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
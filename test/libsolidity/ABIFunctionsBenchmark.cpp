@@ -0,0 +1,87 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Benchmark of the generation of ABI encoding and decoding functions, which is
+ * dominated by the rendering of their templates.
+ * It is disabled by default, run it with
+ * soltest -t ABIFunctionsBenchmark
+ */
+
+#include <libsolidity/codegen/ABIFunctions.h>
+#include <libsolidity/ast/TypeProvider.h>
+
+#include <test/Options.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <iostream>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(ABIFunctionsBenchmark, *boost::unit_test::disabled())
+
+BOOST_AUTO_TEST_CASE(functions_per_second)
+{
+	TypePointers types{
+		TypeProvider::uint256(),
+		TypeProvider::uint(8),
+		TypeProvider::address(),
+		TypeProvider::boolean(),
+		TypeProvider::fixedBytes(32),
+		TypeProvider::bytesMemory(),
+		TypeProvider::stringMemory(),
+		TypeProvider::array(DataLocation::Memory, TypeProvider::uint256()),
+		TypeProvider::array(DataLocation::Memory, TypeProvider::uint(8), 3),
+		TypeProvider::array(DataLocation::Memory, TypeProvider::array(DataLocation::Memory, TypeProvider::uint256()))
+	};
+
+	size_t runs = 0;
+	size_t codeSize = 0;
+	auto start = chrono::steady_clock::now();
+	chrono::duration<double> elapsed{0};
+	for (; elapsed < chrono::seconds(1); elapsed = chrono::steady_clock::now() - start)
+	{
+		// A new collector in every run so that no function is reused.
+		auto collector = make_shared<MultiUseYulFunctionCollector>();
+		ABIFunctions functions(dev::test::Options::get().evmVersion(), collector);
+		functions.tupleEncoder(types, types);
+		functions.tupleEncoderPacked(types, types);
+		functions.tupleDecoder(types);
+		functions.tupleDecoder(types, true);
+		codeSize += collector->requestedFunctions().size();
+		++runs;
+	}
+
+	cout <<
+		"Generated the ABI functions for " << types.size() << " types " << runs << " times (" <<
+		codeSize << " bytes of code) in " << elapsed.count() << "s: " <<
+		size_t(runs / elapsed.count()) << " runs/s" << endl;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
@@ -0,0 +1,170 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Tests for the on-disk cache of compiled contracts.
+ */
+
+#include <test/Options.h>
+#include <test/TemporaryDirectory.h>
+
+#include <libsolidity/interface/ArtifactCache.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <libdevcore/JSON.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <string>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+struct Outputs
+{
+	string object;
+	string runtimeObject;
+	string sourceMapping;
+	string runtimeSourceMapping;
+	string assembly;
+	string assemblyJSON;
+
+	bool operator==(Outputs const& _other) const
+	{
+		return
+			object == _other.object &&
+			runtimeObject == _other.runtimeObject &&
+			sourceMapping == _other.sourceMapping &&
+			runtimeSourceMapping == _other.runtimeSourceMapping &&
+			assembly == _other.assembly &&
+			assemblyJSON == _other.assemblyJSON;
+	}
+};
+
+/// Compiles @a _sources and @returns the outputs of all contracts.
+map<string, Outputs> compile(StringMap const& _sources, string const& _cacheDirectory, unsigned _parallelism = 1)
+{
+	CompilerStack compiler;
+	compiler.setSources(_sources);
+	compiler.setEVMVersion(dev::test::Options::get().evmVersion());
+	compiler.setOptimiserSettings(dev::test::Options::get().optimize);
+	compiler.setLibraries({{"L", h160(0x1234)}});
+	compiler.setParallelism(_parallelism);
+	compiler.setArtifactCacheDirectory(_cacheDirectory);
+	BOOST_REQUIRE(compiler.compile());
+
+	map<string, Outputs> outputs;
+	for (string const& name: compiler.contractNames())
+	{
+		Outputs& output = outputs[name];
+		output.object = compiler.object(name).toHex();
+		output.runtimeObject = compiler.runtimeObject(name).toHex();
+		if (string const* sourceMapping = compiler.sourceMapping(name))
+			output.sourceMapping = *sourceMapping;
+		if (string const* runtimeSourceMapping = compiler.runtimeSourceMapping(name))
+			output.runtimeSourceMapping = *runtimeSourceMapping;
+		output.assembly = compiler.assemblyString(name, _sources);
+		output.assemblyJSON = jsonCompactPrint(compiler.assemblyJSON(name, _sources));
+	}
+	return outputs;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SolidityArtifactCache)
+
+BOOST_AUTO_TEST_CASE(cached_outputs_match_compiled_outputs)
+{
+	StringMap const sources{
+		{"a.sol", "library L { function f() public pure returns (uint) { return 7; } }"},
+		{"b.sol", "import \"a.sol\"; contract B { function g() public pure returns (uint) { return L.f(); } }"},
+		{"c.sol", "import \"b.sol\"; contract C { function h() public returns (B) { return new B(); } }"}
+	};
+	map<string, Outputs> expectation = compile(sources, "");
+
+	dev::test::TemporaryDirectory directory("solc-artifacts");
+	BOOST_CHECK(compile(sources, directory.path().string()) == expectation);
+	BOOST_CHECK_EQUAL(directory.fileCount(), 3);
+	// All contracts are loaded from the cache now.
+	BOOST_CHECK(compile(sources, directory.path().string()) == expectation);
+	BOOST_CHECK(compile(sources, directory.path().string(), 4) == expectation);
+	BOOST_CHECK_EQUAL(directory.fileCount(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(changes_invalidate_entries)
+{
+	StringMap sources{
+		{"a.sol", "contract A { function f() public pure returns (uint) { return 1; } }"},
+		{"b.sol", "contract B { function g() public pure returns (uint) { return 2; } }"}
+	};
+	dev::test::TemporaryDirectory directory("solc-artifacts");
+	compile(sources, directory.path().string());
+	BOOST_CHECK_EQUAL(directory.fileCount(), 2);
+
+	// Other sources influence the AST IDs, so a change in one source invalidates all entries.
+	sources["b.sol"] = "contract B { function g() public pure returns (uint) { return 3; } }";
+	BOOST_CHECK(compile(sources, directory.path().string()) == compile(sources, ""));
+	BOOST_CHECK_EQUAL(directory.fileCount(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_entries_are_ignored)
+{
+	StringMap const sources{{"a.sol", "contract A { function f() public pure returns (uint) { return 1; } }"}};
+	map<string, Outputs> expectation = compile(sources, "");
+
+	dev::test::TemporaryDirectory directory("solc-artifacts");
+	compile(sources, directory.path().string());
+	BOOST_REQUIRE_EQUAL(directory.fileCount(), 1);
+	boost::filesystem::path entry = boost::filesystem::directory_iterator(directory.path())->path();
+	ofstream(entry.string(), ios::binary | ios::trunc) << "solc-artifacts";
+
+	BOOST_CHECK(compile(sources, directory.path().string()) == expectation);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_entries_are_replaced)
+{
+	StringMap const sources{{"a.sol", "contract A { function f() public pure returns (uint) { return 1; } }"}};
+	map<string, Outputs> expectation = compile(sources, "");
+
+	dev::test::TemporaryDirectory directory("solc-artifacts");
+	compile(sources, directory.path().string());
+	BOOST_REQUIRE_EQUAL(directory.fileCount(), 1);
+	boost::filesystem::path entry = boost::filesystem::directory_iterator(directory.path())->path();
+	h256 const key(entry.filename().string());
+	ofstream(entry.string(), ios::binary | ios::trunc) << "solc-artifacts";
+	BOOST_REQUIRE(!ArtifactCache(directory.path().string()).load(key));
+
+	BOOST_CHECK(compile(sources, directory.path().string()) == expectation);
+	BOOST_CHECK_EQUAL(directory.fileCount(), 1);
+	BOOST_CHECK(ArtifactCache(directory.path().string()).load(key));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+} // end namespaces
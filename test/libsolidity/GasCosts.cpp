@@ -81,7 +81,14 @@ namespace test
 		); \
 	} while(0)
 
-BOOST_FIXTURE_TEST_SUITE(GasCostTests, SolidityExecutionFramework)
+/// The gas checks need the metadata from m_compiler, so every contract has to be compiled.
+class GasCostTestFramework: public SolidityExecutionFramework
+{
+public:
+	GasCostTestFramework() { m_useCompilationCache = false; }
+};
+
+BOOST_FIXTURE_TEST_SUITE(GasCostTests, GasCostTestFramework)
 
 BOOST_AUTO_TEST_CASE(string_storage)
 {
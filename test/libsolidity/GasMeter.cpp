@@ -44,6 +44,8 @@ namespace test
 class GasMeterTestFramework: public SolidityExecutionFramework
 {
 public:
+	GasMeterTestFramework() { m_useCompilationCache = false; }
+
 	void compile(string const& _sourceCode)
 	{
 		m_compiler.reset();
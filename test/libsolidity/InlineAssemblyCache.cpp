@@ -0,0 +1,174 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Tests for the cache of the inline assembly snippets of the code generator.
+ */
+
+#include <libsolidity/codegen/CompilerContext.h>
+#include <libsolidity/codegen/InlineAssemblyCache.h>
+
+#include <libyul/AsmData.h>
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace langutil;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+/// @returns a snippet with local variables, which is not optimised.
+/// Each test uses its own snippets, so that they are not cached by other tests.
+string assignment(unsigned _id)
+{
+	return "{ a := add(a, mul(b, " + to_string(_id) + ")) }";
+}
+
+/// @returns a snippet without local variables, which is optimised if the optimiser is enabled.
+string functions(unsigned _id)
+{
+	return R"({
+		function f(x) -> y { y := add(x, )" + to_string(_id) + R"() }
+		function g(x) -> y { y := f(f(x)) }
+		sstore(0, g(calldataload(0)))
+	})";
+}
+
+/// Assembles @a _assembly in a new context and @returns the bytecode.
+bytes assemble(
+	string const& _assembly,
+	vector<string> const& _localVariables = {},
+	OptimiserSettings const& _settings = OptimiserSettings::none(),
+	EVMVersion _evmVersion = EVMVersion{}
+)
+{
+	CompilerContext context(_evmVersion);
+	for (size_t i = 0; i < _localVariables.size(); ++i)
+		context << u256(i + 1);
+	context.appendInlineAssembly(_assembly, _localVariables, {}, false, _settings);
+	return context.assembledObject().bytecode;
+}
+
+/// @returns the number of cache hits and misses caused by @a _function.
+template <class F>
+pair<size_t, size_t> cacheAccesses(F const& _function)
+{
+	InlineAssemblyCache::Statistics before = InlineAssemblyCache::instance().statistics();
+	_function();
+	InlineAssemblyCache::Statistics after = InlineAssemblyCache::instance().statistics();
+	return {after.hits - before.hits, after.misses - before.misses};
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(InlineAssemblyCacheTest)
+
+BOOST_AUTO_TEST_CASE(hit_returns_identical_code)
+{
+	for (OptimiserSettings const& settings: {OptimiserSettings::none(), OptimiserSettings::full()})
+	{
+		bytes first;
+		bytes second;
+		auto accesses = cacheAccesses([&]() { first = assemble(functions(1), {}, settings); });
+		BOOST_CHECK_EQUAL(accesses.first, 0);
+		BOOST_CHECK_EQUAL(accesses.second, 1);
+		accesses = cacheAccesses([&]() { second = assemble(functions(1), {}, settings); });
+		BOOST_CHECK_EQUAL(accesses.first, 1);
+		BOOST_CHECK_EQUAL(accesses.second, 0);
+		BOOST_CHECK(!first.empty());
+		BOOST_CHECK(first == second);
+	}
+	bytes first = assemble(assignment(1), {"a", "b"});
+	auto accesses = cacheAccesses([&]() { BOOST_CHECK(assemble(assignment(1), {"a", "b"}) == first); });
+	BOOST_CHECK_EQUAL(accesses.first, 1);
+}
+
+BOOST_AUTO_TEST_CASE(miss_on_different_settings)
+{
+	OptimiserSettings settings = OptimiserSettings::full();
+	assemble(functions(2), {}, settings, EVMVersion::petersburg());
+
+	auto expectMiss = [&](function<void()> const& _assemble)
+	{
+		auto accesses = cacheAccesses(_assemble);
+		BOOST_CHECK_EQUAL(accesses.first, 0);
+		BOOST_CHECK_EQUAL(accesses.second, 1);
+	};
+	expectMiss([&]() { assemble(functions(2), {}, settings, EVMVersion::byzantium()); });
+	expectMiss([&]() { assemble(functions(2), {}, OptimiserSettings::minimal(), EVMVersion::petersburg()); });
+	OptimiserSettings otherRuns = settings;
+	otherRuns.expectedExecutionsPerDeployment++;
+	expectMiss([&]() { assemble(functions(2), {}, otherRuns, EVMVersion::petersburg()); });
+	OptimiserSettings otherStackAllocation = settings;
+	otherStackAllocation.optimizeStackAllocation = !settings.optimizeStackAllocation;
+	expectMiss([&]() { assemble(functions(2), {}, otherStackAllocation, EVMVersion::petersburg()); });
+
+	assemble(assignment(2), {"a", "b"});
+	bytes swapped;
+	expectMiss([&]() { swapped = assemble(assignment(2), {"b", "a"}); });
+	expectMiss([&]() { assemble(assignment(2), {"a", "b", "c"}); });
+	BOOST_CHECK(swapped != assemble(assignment(2), {"a", "b"}));
+}
+
+BOOST_AUTO_TEST_CASE(eviction)
+{
+	InlineAssemblyCache& cache = InlineAssemblyCache::instance();
+	assemble(functions(3));
+	auto accesses = cacheAccesses([&]() { assemble(functions(3)); });
+	BOOST_CHECK_EQUAL(accesses.first, 1);
+
+	// Resetting the Yul string repository clears the cache.
+	{
+		yul::YulStringRepository::Session session;
+	}
+	accesses = cacheAccesses([&]() { assemble(functions(3)); });
+	BOOST_CHECK_EQUAL(accesses.second, 1);
+
+	{
+		yul::YulStringRepository::Session session;
+	}
+
+	auto snippet = make_shared<InlineAssemblyCache::Snippet const>(InlineAssemblyCache::Snippet{
+		make_shared<yul::Block>(),
+		{},
+		{}
+	});
+	for (size_t i = 0; i < InlineAssemblyCache::c_maxSnippets; ++i)
+		cache.store("eviction" + to_string(i), snippet);
+	BOOST_CHECK(cache.lookup("eviction0") == snippet);
+	BOOST_CHECK(cache.lookup("eviction" + to_string(InlineAssemblyCache::c_maxSnippets - 1)) == snippet);
+
+	// The cache is full, so the next snippet clears it.
+	cache.store("eviction", snippet);
+	BOOST_CHECK(cache.lookup("eviction") == snippet);
+	BOOST_CHECK(!cache.lookup("eviction0"));
+	BOOST_CHECK(!cache.lookup("eviction" + to_string(InlineAssemblyCache::c_maxSnippets - 1)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+} // end namespaces
@@ -21,8 +21,11 @@
 #include <test/libsolidity/AnalysisFramework.h>
 #include <test/Options.h>
 
+#include <liblangutil/SourceReferenceFormatter.h>
+
 #include <boost/test/unit_test.hpp>
 
+#include <sstream>
 #include <string>
 
 using namespace std;
@@ -333,6 +336,51 @@ BOOST_AUTO_TEST_CASE(import_library)
 
 }
 
+BOOST_AUTO_TEST_CASE(parallel_queries)
+{
+	string const source = R"(
+		pragma experimental SMTChecker;
+		contract C {
+			uint x;
+			function f(uint a, uint b) public returns (uint) {
+				x = a + b;
+				if (a > b && b > a)
+					x = 0;
+				assembly { }
+				return a / b;
+			}
+			function g(uint8 y) public view {
+				assembly { }
+				assert(x > y);
+				while (y < 3) { ++y; }
+			}
+			function h(uint z) public pure returns (uint) {
+				require(z < 10);
+				assert(z < 10);
+				return z - 1;
+			}
+		}
+	)";
+	auto warnings = [&](unsigned _jobs)
+	{
+		CompilerStack c;
+		c.setSources({{"", source}});
+		c.setEVMVersion(dev::test::Options::get().evmVersion());
+		c.setParallelism(_jobs);
+		BOOST_CHECK(c.parseAndAnalyze());
+		ostringstream output;
+		SourceReferenceFormatter formatter(output);
+		for (auto const& error: c.errors())
+			formatter.printErrorInformation(*error);
+		return output.str();
+	};
+	string const expectation = warnings(1);
+	BOOST_CHECK(expectation.find("Overflow") != string::npos);
+	BOOST_CHECK(expectation.find("inline assembly") != string::npos);
+	for (unsigned jobs: {2, 3, 4})
+		BOOST_CHECK_EQUAL(warnings(jobs), expectation);
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
 
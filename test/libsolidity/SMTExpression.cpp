@@ -0,0 +1,87 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the representation of SMT expressions.
+ */
+
+#include <libsolidity/formal/SolverInterface.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+using smt::Expression;
+
+BOOST_AUTO_TEST_SUITE(SMTExpression)
+
+BOOST_AUTO_TEST_CASE(structurally_equal_expressions_are_shared)
+{
+	Expression a = Expression(size_t(1)) + Expression(size_t(2)) * Expression(size_t(3));
+	Expression b = Expression(size_t(1)) + Expression(size_t(2)) * Expression(size_t(3));
+	BOOST_CHECK(a.identical(b));
+	BOOST_CHECK_EQUAL(a.hash(), b.hash());
+	BOOST_CHECK(&a.arguments() == &b.arguments());
+	BOOST_CHECK(a.op() == smt::Operator::Add);
+	BOOST_CHECK(a.hasCorrectArity());
+
+	BOOST_CHECK(!a.identical(Expression(size_t(1)) + Expression(size_t(3)) * Expression(size_t(2))));
+	BOOST_CHECK(!Expression(size_t(1)).identical(Expression(true)));
+	BOOST_CHECK(!(Expression(size_t(1)) - Expression(size_t(2))).identical(Expression(size_t(2)) - Expression(size_t(1))));
+}
+
+BOOST_AUTO_TEST_CASE(arity)
+{
+	Expression one(size_t(1));
+	BOOST_CHECK(!one.hasCorrectArity());
+	BOOST_CHECK((!Expression(true)).hasCorrectArity());
+	BOOST_CHECK(Expression::ite(Expression(true), one, one).hasCorrectArity());
+	BOOST_CHECK(Expression::ite(Expression(true), one, one).op() == smt::Operator::Ite);
+}
+
+BOOST_AUTO_TEST_CASE(expressions_of_other_threads)
+{
+	Expression local = Expression(size_t(7)) < Expression(size_t(8));
+	Expression other(false);
+	thread([&]() { other = Expression(size_t(7)) < Expression(size_t(8)); }).join();
+	BOOST_CHECK(local.identical(other));
+	BOOST_CHECK_EQUAL(local.hash(), other.hash());
+}
+
+BOOST_AUTO_TEST_CASE(shared_subexpressions)
+{
+	// Without sharing, this expression would have 2^100 leaves.
+	Expression x(size_t(0));
+	for (size_t i = 0; i < 100; ++i)
+		x = Expression::ite(x < Expression(i), x + Expression(size_t(1)), x);
+	BOOST_CHECK(x.arguments().at(2).identical(x.arguments().at(0).arguments().at(0)));
+	BOOST_CHECK(x.identical(x));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
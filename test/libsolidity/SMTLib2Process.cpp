@@ -0,0 +1,298 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Tests for querying an SMT-LIB2 solver in a separate process.
+ */
+
+#include <test/TemporaryDirectory.h>
+
+#include <libsolidity/formal/SMTLib2Interface.h>
+#include <libsolidity/formal/SMTLib2Process.h>
+#include <libsolidity/formal/SMTPortfolio.h>
+#include <libsolidity/formal/SMTQueryCache.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+// The stand-in solver is a shell script.
+#ifndef _WIN32
+
+using smt::CheckResult;
+
+namespace
+{
+
+/// Shell script that logs its input and answers every query with its first argument. If the
+/// second argument is "crash", it exits after answering the first check, before the end of
+/// the response. If it is "slow", it waits with every answer until it is released. Its name
+/// and version are read from the files "name" and "version".
+string const c_solver = R"SH(
+directory="$(dirname "$0")"
+log="$directory/input.log"
+while IFS= read -r line; do
+	printf '%s\n' "$line" >> "$log"
+	case "$line" in
+		"(check-sat)")
+			if [ "$2" = "slow" ]; then
+				while [ ! -e "$directory/released" ]; do sleep 0.01; done
+			fi
+			checked=1
+			echo "$1" ;;
+		"(get-info :name)")
+			echo "(:name \"$(cat "$directory/name")\")" ;;
+		"(get-info :version)")
+			echo "(:version \"$(cat "$directory/version")\")" ;;
+		"(get-value "*)
+			echo "((|EVALEXPR_0| 42))" ;;
+		"(echo "*)
+			if [ "$2" = "crash" ] && [ -n "$checked" ]; then exit 1; fi
+			text="${line#(echo \"}"
+			echo "${text%\")}" ;;
+	esac
+done
+)SH";
+
+class StandInSolver
+{
+public:
+	StandInSolver(): m_directory("solc-smtlib2")
+	{
+		boost::filesystem::create_directories(m_directory.path());
+		ofstream((m_directory.path() / "solver.sh").string()) << c_solver;
+		setInfo("stand-in", "1");
+	}
+
+	/// Sets the name and version that the solver reports from now on.
+	void setInfo(string const& _name, string const& _version)
+	{
+		ofstream((m_directory.path() / "name").string()) << _name;
+		ofstream((m_directory.path() / "version").string()) << _version;
+	}
+
+	string command(string const& _arguments) const { return "sh " + (m_directory.path() / "solver.sh").string() + " " + _arguments; }
+
+	/// Lets a slow solver answer its queries.
+	void release() const { ofstream((m_directory.path() / "released").string()); }
+
+	/// @returns how often @a _line was sent to the solver.
+	size_t count(string const& _line) const
+	{
+		ifstream log((m_directory.path() / "input.log").string());
+		string line;
+		size_t count = 0;
+		while (getline(log, line))
+			if (line == _line)
+				++count;
+		return count;
+	}
+
+private:
+	dev::test::TemporaryDirectory m_directory;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTLib2ProcessTest)
+
+BOOST_AUTO_TEST_CASE(incremental_session)
+{
+	StandInSolver standIn;
+	map<h256, string> responses;
+	smt::SMTLib2Interface solver(responses, standIn.command("unsat"));
+	smt::Expression x = solver.newVariable("x", make_shared<smt::Sort>(smt::Kind::Int));
+	for (int i = 0; i < 3; ++i)
+	{
+		solver.push();
+		solver.addAssertion(x > i);
+		BOOST_CHECK(solver.check({}).first == CheckResult::UNSATISFIABLE);
+		solver.pop();
+	}
+	BOOST_CHECK(solver.unhandledQueries().empty());
+	// A single process receives the declaration once and only the new commands per query.
+	BOOST_CHECK_EQUAL(standIn.count("(declare-fun |x| () Int)"), 1);
+	BOOST_CHECK_EQUAL(standIn.count("(set-logic QF_UFLIA)"), 1);
+	BOOST_CHECK_EQUAL(standIn.count("(check-sat)"), 3);
+	BOOST_CHECK_EQUAL(standIn.count("(assert (> x 1))"), 1);
+}
+
+BOOST_AUTO_TEST_CASE(values)
+{
+	StandInSolver standIn;
+	map<h256, string> responses;
+	smt::SMTLib2Interface solver(responses, standIn.command("sat"));
+	smt::Expression x = solver.newVariable("x", make_shared<smt::Sort>(smt::Kind::Int));
+	solver.addAssertion(x == 42);
+	auto result = solver.check({x});
+	BOOST_CHECK(result.first == CheckResult::SATISFIABLE);
+	BOOST_CHECK(result.second == vector<string>{"42"});
+}
+
+BOOST_AUTO_TEST_CASE(restart)
+{
+	StandInSolver standIn;
+	map<h256, string> responses;
+	smt::SMTLib2Interface solver(responses, standIn.command("unsat crash"));
+	smt::Expression x = solver.newVariable("x", make_shared<smt::Sort>(smt::Kind::Int));
+	solver.push();
+	solver.addAssertion(x > 0);
+	BOOST_CHECK(solver.check({}).first == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK(solver.check({}).first == CheckResult::UNSATISFIABLE);
+	// The state is sent again to the new process.
+	BOOST_CHECK_EQUAL(standIn.count("(declare-fun |x| () Int)"), 2);
+	BOOST_CHECK_EQUAL(standIn.count("(assert (> x 0))"), 2);
+	BOOST_CHECK_EQUAL(standIn.count("(check-sat)"), 2);
+}
+
+BOOST_AUTO_TEST_CASE(timeout)
+{
+	StandInSolver standIn;
+	map<h256, string> responses;
+	smt::SMTLib2Interface solver(responses, standIn.command("unsat slow"), chrono::milliseconds(40));
+	smt::Expression x = solver.newVariable("x", make_shared<smt::Sort>(smt::Kind::Int));
+	solver.addAssertion(x > 0);
+	auto start = chrono::steady_clock::now();
+	BOOST_CHECK(solver.check({}).first == CheckResult::UNKNOWN);
+	BOOST_CHECK(solver.check({}).first == CheckResult::UNKNOWN);
+	// The stand-in solver is never released, but it is terminated after the timeout.
+	BOOST_CHECK(chrono::steady_clock::now() - start < chrono::seconds(4));
+	// The state is sent again to the restarted process.
+	BOOST_CHECK_EQUAL(standIn.count("(declare-fun |x| () Int)"), 2);
+	BOOST_CHECK_EQUAL(standIn.count("(check-sat)"), 2);
+	// The stand-in solver has no timeout option.
+	BOOST_CHECK_EQUAL(standIn.count("(set-option :timeout 40)"), 0);
+}
+
+BOOST_AUTO_TEST_CASE(timeout_option)
+{
+	StandInSolver standIn;
+	standIn.setInfo("Z3", "4.8.7");
+	map<h256, string> responses;
+	smt::SMTLib2Interface solver(responses, standIn.command("unsat"), chrono::milliseconds(40));
+	BOOST_CHECK_EQUAL(solver.solverVersion(), "Z3 4.8.7");
+	solver.reset();
+	BOOST_CHECK(solver.check({}).first == CheckResult::UNSATISFIABLE);
+	// The option is sent when the solver is started and after every reset.
+	BOOST_CHECK_EQUAL(standIn.count("(set-option :timeout 40)"), 2);
+}
+
+BOOST_AUTO_TEST_CASE(interrupt)
+{
+	StandInSolver standIn;
+	map<h256, string> responses;
+	smt::SMTLib2Interface solver(responses, standIn.command("unsat slow"));
+	smt::Expression x = solver.newVariable("x", make_shared<smt::Sort>(smt::Kind::Int));
+	solver.addAssertion(x > 0);
+	// An interruption has no effect before the query started, so it is repeated until the
+	// query returns.
+	atomic<bool> returned{false};
+	thread interrupter([&]() {
+		while (!returned)
+		{
+			solver.interrupt();
+			this_thread::sleep_for(chrono::milliseconds(1));
+		}
+	});
+	// The solver only answers once it is released, so the query was interrupted.
+	BOOST_CHECK(solver.check({}).first == CheckResult::UNKNOWN);
+	returned = true;
+	interrupter.join();
+
+	// The same process answers the next query, after it answered the interrupted one.
+	standIn.release();
+	BOOST_CHECK(solver.check({}).first == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK_EQUAL(standIn.count("(check-sat)"), 2);
+	BOOST_CHECK_EQUAL(standIn.count("(declare-fun |x| () Int)"), 1);
+	BOOST_CHECK_EQUAL(standIn.count("(assert (> x 0))"), 1);
+}
+
+BOOST_AUTO_TEST_CASE(cache_key_includes_solver_version)
+{
+	StandInSolver standIn;
+	auto cache = make_shared<smt::SMTQueryCache>();
+	map<h256, string> responses;
+	auto check = [&]()
+	{
+		smt::SMTPortfolio solver(responses, standIn.command("unsat"));
+		solver.setQueryCache(cache);
+		smt::Expression x = solver.newVariable("x", make_shared<smt::Sort>(smt::Kind::Int));
+		solver.addAssertion(x > 0);
+		solver.check({});
+	};
+	check();
+	check();
+	BOOST_CHECK_EQUAL(cache->hits(), 1);
+	BOOST_CHECK_EQUAL(cache->misses(), 1);
+	// An updated solver does not get the answers of the old one.
+	standIn.setInfo("stand-in", "2");
+	check();
+	BOOST_CHECK_EQUAL(cache->hits(), 1);
+	BOOST_CHECK_EQUAL(cache->misses(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(solver_exits_before_reading)
+{
+	struct sigaction before;
+	BOOST_REQUIRE(sigaction(SIGPIPE, nullptr, &before) == 0);
+
+	smt::SMTLib2Process process("sh -c exit", chrono::seconds(10));
+	process.start();
+	for (int i = 0; i < 1000 && process.running(); ++i)
+		this_thread::sleep_for(chrono::milliseconds(10));
+	BOOST_REQUIRE(!process.running());
+	// More than fits into the pipe, so that the write fails even if the input is buffered.
+	string const commands(1 << 20, ' ');
+	process.send(commands);
+	auto response = process.query(commands);
+	BOOST_REQUIRE(response);
+	BOOST_CHECK(response->empty());
+
+	// Writing to the terminated solver neither killed the process nor changed how it handles SIGPIPE.
+	struct sigaction after;
+	BOOST_REQUIRE(sigaction(SIGPIPE, nullptr, &after) == 0);
+	BOOST_CHECK(after.sa_handler == before.sa_handler);
+}
+
+BOOST_AUTO_TEST_CASE(missing_solver)
+{
+	map<h256, string> responses;
+	smt::SMTLib2Interface solver(responses, "solc-test-missing-smt-solver");
+	BOOST_CHECK_THROW(solver.check({}), smt::SolverError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
+
+}
+}
+} // end namespaces
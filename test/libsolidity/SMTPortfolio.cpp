@@ -0,0 +1,219 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Tests for combining the answers of several SMT solvers.
+ */
+
+#include <libsolidity/formal/SMTPortfolio.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+using smt::CheckResult;
+
+namespace
+{
+
+/// Solver that gives a fixed answer. If it follows another stand-in solver, it answers each
+/// query only after that solver answered it, so that the order of the answers does not depend
+/// on timing. If it is blocking, it only returns once it is interrupted.
+class StandInSolver: public smt::SolverInterface
+{
+public:
+	StandInSolver(CheckResult _result, vector<string> _values, StandInSolver const* _predecessor = nullptr, bool _blocking = false):
+		m_result(_result), m_values(move(_values)), m_predecessor(_predecessor), m_blocking(_blocking)
+	{}
+
+	void reset() override {}
+	void push() override {}
+	void pop() override {}
+	void declareVariable(string const&, smt::Sort const&) override {}
+	void addAssertion(smt::Expression const&) override {}
+
+	pair<CheckResult, vector<string>> check(vector<smt::Expression> const&) override
+	{
+		unique_lock<mutex> lock(m_mutex);
+		size_t const query = ++m_queries;
+		lock.unlock();
+		if (m_predecessor)
+			m_predecessor->waitForAnswer(query);
+		lock.lock();
+		if (m_blocking)
+		{
+			m_condition.wait(lock, [&]() { return m_interrupted; });
+			m_interrupted = false;
+			return {CheckResult::UNKNOWN, {}};
+		}
+		++m_answers;
+		m_condition.notify_all();
+		return {m_result, m_values};
+	}
+
+	void interrupt() override
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_interrupted = true;
+		++interruptions;
+		m_condition.notify_all();
+	}
+
+	/// Waits until the solver answered @a _queries queries.
+	void waitForAnswer(size_t _queries) const
+	{
+		unique_lock<mutex> lock(m_mutex);
+		m_condition.wait(lock, [&]() { return m_answers >= _queries; });
+	}
+
+	atomic<size_t> interruptions{0};
+
+private:
+	CheckResult const m_result;
+	vector<string> const m_values;
+	StandInSolver const* m_predecessor;
+	bool const m_blocking;
+	mutable mutex m_mutex;
+	mutable condition_variable m_condition;
+	size_t m_queries = 0;
+	size_t m_answers = 0;
+	bool m_interrupted = false;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTPortfolioTest)
+
+BOOST_AUTO_TEST_CASE(race_uses_values_of_first_solver_that_answers)
+{
+	map<h256, string> responses;
+	auto fast = make_unique<StandInSolver>(CheckResult::SATISFIABLE, vector<string>{"2"});
+	auto slow = make_unique<StandInSolver>(CheckResult::SATISFIABLE, vector<string>{"1"}, fast.get());
+	auto blocking = make_unique<StandInSolver>(CheckResult::SATISFIABLE, vector<string>{"3"}, nullptr, true);
+	StandInSolver* slowSolver = slow.get();
+	StandInSolver* blockingSolver = blocking.get();
+	vector<unique_ptr<smt::SolverInterface>> solvers;
+	solvers.emplace_back(move(slow));
+	solvers.emplace_back(move(fast));
+	solvers.emplace_back(move(blocking));
+	smt::SMTPortfolio portfolio(responses, move(solvers));
+	smt::Expression x = portfolio.newVariable("x", make_shared<smt::Sort>(smt::Kind::Int));
+
+	for (size_t i = 0; i < 3; ++i)
+	{
+		// The SMT-LIB2 interface does not answer, so the slow solver decides even though
+		// the fast one answers first.
+		auto result = portfolio.check({x});
+		BOOST_CHECK(result.first == CheckResult::SATISFIABLE);
+		BOOST_CHECK(result.second == vector<string>{"1"});
+	}
+	BOOST_CHECK_EQUAL(slowSolver->interruptions.load(), 0);
+	BOOST_CHECK(blockingSolver->interruptions.load() >= 3);
+}
+
+BOOST_AUTO_TEST_CASE(race_uses_first_answer_without_values)
+{
+	map<h256, string> responses;
+	auto blocking = make_unique<StandInSolver>(CheckResult::SATISFIABLE, vector<string>{}, nullptr, true);
+	auto unsatisfiable = make_unique<StandInSolver>(CheckResult::UNSATISFIABLE, vector<string>{});
+	StandInSolver* blockingSolver = blocking.get();
+	vector<unique_ptr<smt::SolverInterface>> solvers;
+	solvers.emplace_back(move(blocking));
+	solvers.emplace_back(move(unsatisfiable));
+	smt::SMTPortfolio portfolio(responses, move(solvers));
+	smt::Expression x = portfolio.newVariable("x", make_shared<smt::Sort>(smt::Kind::Int));
+
+	// The blocking solver comes first, but it only returns once it is interrupted, which
+	// happens as soon as the unsatisfiable answer arrives, even if values are requested.
+	BOOST_CHECK(portfolio.check({}).first == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK(portfolio.check({x}).first == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK(blockingSolver->interruptions.load() >= 2);
+}
+
+BOOST_AUTO_TEST_CASE(race_without_answer)
+{
+	map<h256, string> responses;
+	vector<unique_ptr<smt::SolverInterface>> solvers;
+	solvers.emplace_back(make_unique<StandInSolver>(CheckResult::ERROR, vector<string>{}));
+	solvers.emplace_back(make_unique<StandInSolver>(CheckResult::ERROR, vector<string>{}));
+	smt::SMTPortfolio portfolio(responses, move(solvers));
+	// The SMT-LIB2 interface returns UNKNOWN, which is preferred over ERROR.
+	BOOST_CHECK(portfolio.check({}).first == CheckResult::UNKNOWN);
+	BOOST_CHECK_EQUAL(portfolio.unhandledQueries().size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(wait_for_all_solvers_reports_conflicts)
+{
+	map<h256, string> responses;
+	// Unless the solvers are queried one after the other, the unsatisfiable answer arrives first.
+	auto makePortfolio = [&](bool _sequential)
+	{
+		auto unsatisfiable = make_unique<StandInSolver>(CheckResult::UNSATISFIABLE, vector<string>{});
+		auto satisfiable = make_unique<StandInSolver>(
+			CheckResult::SATISFIABLE,
+			vector<string>{"1"},
+			_sequential ? nullptr : unsatisfiable.get()
+		);
+		vector<unique_ptr<smt::SolverInterface>> solvers;
+		solvers.emplace_back(move(satisfiable));
+		solvers.emplace_back(move(unsatisfiable));
+		return make_unique<smt::SMTPortfolio>(responses, move(solvers));
+	};
+
+	BOOST_CHECK(makePortfolio(false)->check({}).first == CheckResult::UNSATISFIABLE);
+
+	// The unsatisfiable answer decides even though the satisfiable solver comes first and
+	// values are requested.
+	auto withValues = makePortfolio(false);
+	smt::Expression x = withValues->newVariable("x", make_shared<smt::Sort>(smt::Kind::Int));
+	BOOST_CHECK(withValues->check({x}).first == CheckResult::UNSATISFIABLE);
+
+	auto waiting = makePortfolio(true);
+	waiting->setWaitForAllSolvers();
+	BOOST_CHECK(waiting->check({}).first == CheckResult::CONFLICTING);
+}
+
+BOOST_AUTO_TEST_CASE(wait_for_all_solvers_uses_first_answer)
+{
+	map<h256, string> responses;
+	vector<unique_ptr<smt::SolverInterface>> solvers;
+	solvers.emplace_back(make_unique<StandInSolver>(CheckResult::UNKNOWN, vector<string>{}));
+	solvers.emplace_back(make_unique<StandInSolver>(CheckResult::SATISFIABLE, vector<string>{"1"}));
+	solvers.emplace_back(make_unique<StandInSolver>(CheckResult::SATISFIABLE, vector<string>{"2"}));
+	smt::SMTPortfolio portfolio(responses, move(solvers));
+	portfolio.setWaitForAllSolvers();
+	auto result = portfolio.check({});
+	BOOST_CHECK(result.first == CheckResult::SATISFIABLE);
+	BOOST_CHECK(result.second == vector<string>{"1"});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+} // end namespaces
@@ -0,0 +1,168 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Tests for the cache of SMT query results.
+ */
+
+#include <test/TemporaryDirectory.h>
+
+#include <libsolidity/formal/SMTPortfolio.h>
+#include <libsolidity/formal/SMTQueryCache.h>
+
+#include <libdevcore/Keccak256.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+using smt::CheckResult;
+
+namespace
+{
+
+pair<CheckResult, vector<string>> checkPositive(shared_ptr<smt::SMTQueryCache> _cache)
+{
+	map<h256, string> responses;
+	smt::SMTPortfolio solver(responses);
+	solver.setQueryCache(move(_cache));
+	smt::Expression x = solver.newVariable("x", make_shared<smt::Sort>(smt::Kind::Int));
+	solver.addAssertion(x > 10);
+	solver.addAssertion(x < 12);
+	return solver.check({x});
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTQueryCacheTest)
+
+BOOST_AUTO_TEST_CASE(lookup_and_store)
+{
+	smt::SMTQueryCache cache;
+	BOOST_CHECK(!cache.lookup(keccak256("a")));
+	cache.store(keccak256("a"), {CheckResult::SATISFIABLE, {"1", "true"}});
+	cache.store(keccak256("b"), {CheckResult::UNSATISFIABLE, {}});
+	auto a = cache.lookup(keccak256("a"));
+	BOOST_REQUIRE(a);
+	BOOST_CHECK(a->first == CheckResult::SATISFIABLE);
+	BOOST_CHECK(a->second == vector<string>({"1", "true"}));
+	auto b = cache.lookup(keccak256("b"));
+	BOOST_REQUIRE(b);
+	BOOST_CHECK(b->first == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK_EQUAL(cache.hits(), 2);
+	BOOST_CHECK_EQUAL(cache.misses(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(non_answers_are_not_stored)
+{
+	smt::SMTQueryCache cache;
+	cache.store(keccak256("a"), {CheckResult::UNKNOWN, {}});
+	cache.store(keccak256("b"), {CheckResult::ERROR, {}});
+	cache.store(keccak256("c"), {CheckResult::CONFLICTING, {}});
+	BOOST_CHECK(!cache.lookup(keccak256("a")));
+	BOOST_CHECK(!cache.lookup(keccak256("b")));
+	BOOST_CHECK(!cache.lookup(keccak256("c")));
+	BOOST_CHECK_EQUAL(cache.misses(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(entries_on_disk)
+{
+	dev::test::TemporaryDirectory directory("solc-smt");
+	vector<string> const values{"(- 1)", "", "two\nlines"};
+	smt::SMTQueryCache(directory.path().string()).store(keccak256("a"), {CheckResult::SATISFIABLE, values});
+
+	smt::SMTQueryCache cache(directory.path().string());
+	auto a = cache.lookup(keccak256("a"));
+	BOOST_REQUIRE(a);
+	BOOST_CHECK(a->first == CheckResult::SATISFIABLE);
+	BOOST_CHECK(a->second == values);
+	BOOST_CHECK(!cache.lookup(keccak256("b")));
+
+	ofstream((directory.path() / keccak256("b").hex()).string(), ios::binary) << "solc-smt-cache 1\nsat\n10\nabc";
+	BOOST_CHECK(!cache.lookup(keccak256("b")));
+}
+
+BOOST_AUTO_TEST_CASE(invalid_entries_are_replaced)
+{
+	dev::test::TemporaryDirectory directory("solc-smt");
+	string const path = (directory.path() / keccak256("a").hex()).string();
+	boost::filesystem::create_directories(directory.path().string());
+	ofstream(path, ios::binary) << "solc-smt-cache 1\nsat\n10\nabc";
+	BOOST_REQUIRE(!smt::SMTQueryCache(directory.path().string()).lookup(keccak256("a")));
+
+	smt::SMTQueryCache(directory.path().string()).store(keccak256("a"), {CheckResult::SATISFIABLE, {"1"}});
+	auto a = smt::SMTQueryCache(directory.path().string()).lookup(keccak256("a"));
+	BOOST_REQUIRE(a);
+	BOOST_CHECK(a->second == vector<string>{"1"});
+	BOOST_CHECK_EQUAL(directory.fileCount(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_access)
+{
+	smt::SMTQueryCache cache;
+	vector<thread> threads;
+	for (size_t t = 0; t < 4; ++t)
+		threads.emplace_back([&cache]() {
+			for (size_t i = 0; i < 200; ++i)
+			{
+				h256 key = keccak256(to_string(i));
+				if (!cache.lookup(key))
+					cache.store(key, {CheckResult::SATISFIABLE, {to_string(i)}});
+			}
+		});
+	for (auto& thread: threads)
+		thread.join();
+	for (size_t i = 0; i < 200; ++i)
+	{
+		auto entry = cache.lookup(keccak256(to_string(i)));
+		BOOST_REQUIRE(entry);
+		BOOST_CHECK_EQUAL(entry->second.at(0), to_string(i));
+	}
+	BOOST_CHECK_EQUAL(cache.hits() + cache.misses(), 4 * 200 + 200);
+}
+
+BOOST_AUTO_TEST_CASE(portfolio_uses_cache)
+{
+	auto cache = make_shared<smt::SMTQueryCache>();
+	auto result = checkPositive(cache);
+	// Without linked solvers the query is not answered and not cached.
+	if (result.first != CheckResult::SATISFIABLE)
+		return;
+	BOOST_CHECK(result.second == vector<string>{"11"});
+	BOOST_CHECK_EQUAL(cache->misses(), 1);
+
+	BOOST_CHECK(checkPositive(cache) == result);
+	BOOST_CHECK_EQUAL(cache->hits(), 1);
+	BOOST_CHECK_EQUAL(cache->misses(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
@@ -39,6 +39,9 @@ namespace fs = boost::filesystem;
 SemanticTest::SemanticTest(string const& _filename, langutil::EVMVersion _evmVersion):
 	SolidityExecutionFramework(_evmVersion)
 {
+	// The ABI of the contract is taken from m_compiler after deployment.
+	m_useCompilationCache = false;
+
 	ifstream file(_filename);
 	soltestAssert(file, "Cannot open test contract: \"" + _filename + "\".");
 	file.exceptions(ios::badbit);
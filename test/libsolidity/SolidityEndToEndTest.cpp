@@ -12040,6 +12040,7 @@ BOOST_AUTO_TEST_CASE(include_creation_bytecode_only_once)
 			}
 		}
 	)";
+	m_useCompilationCache = false;
 	compileAndRun(sourceCode);
 	BOOST_CHECK_LE(
 		double(m_compiler.object("Double").bytecode.size()),
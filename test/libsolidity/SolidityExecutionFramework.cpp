@@ -21,8 +21,10 @@
  */
 
 #include <cstdlib>
+#include <iostream>
 #include <boost/test/framework.hpp>
 #include <test/libsolidity/SolidityExecutionFramework.h>
+#include <libdevcore/Keccak256.h>
 
 using namespace dev;
 using namespace dev::test;
@@ -30,6 +32,49 @@ using namespace dev::solidity;
 using namespace dev::solidity::test;
 using namespace std;
 
+CompilationCache& CompilationCache::get()
+{
+	static CompilationCache instance;
+	return instance;
+}
+
+CompilationCache::CompilationCache():
+	m_printStatistics(dev::test::Options::get().showCompilationCacheStatistics)
+{
+}
+
+CompilationCache::~CompilationCache()
+{
+	if (m_printStatistics)
+		printStatistics(cout);
+}
+
+boost::optional<bytes> CompilationCache::lookup(h256 const& _key)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_lookups++;
+	auto it = m_bytecode.find(_key);
+	if (it == m_bytecode.end())
+		return {};
+	m_hits++;
+	return it->second;
+}
+
+void CompilationCache::store(h256 const& _key, bytes _bytecode)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_bytecode[_key] = std::move(_bytecode);
+}
+
+void CompilationCache::printStatistics(ostream& _stream) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	_stream << "Compilation cache: " << m_hits << " hits in " << m_lookups << " lookups";
+	if (m_lookups > 0)
+		_stream << " (" << (100 * m_hits / m_lookups) << "%)";
+	_stream << ", " << m_bytecode.size() << " contracts cached." << endl;
+}
+
 bytes SolidityExecutionFramework::compileContract(
 	string const& _sourceCode,
 	string const& _contractName,
@@ -44,13 +89,40 @@ bytes SolidityExecutionFramework::compileContract(
 	)
 		sourceCode += "pragma experimental ABIEncoderV2;\n";
 	sourceCode += _sourceCode;
+
 	m_compiler.reset();
+
+	h256 cacheKey;
+	if (m_useCompilationCache)
+	{
+		string key = sourceCode + '\0' + _contractName + '\0' + m_evmVersion.name() + '\0';
+		for (auto const& library: _libraryAddresses)
+			key += library.first + '\0' + library.second.hex() + '\0';
+		for (bool flag: {
+			m_compileViaYul,
+			m_optimiserSettings.runOrderLiterals,
+			m_optimiserSettings.runJumpdestRemover,
+			m_optimiserSettings.runPeephole,
+			m_optimiserSettings.runDeduplicate,
+			m_optimiserSettings.runCSE,
+			m_optimiserSettings.runConstantOptimiser,
+			m_optimiserSettings.optimizeStackAllocation,
+			m_optimiserSettings.runYulOptimiser
+		})
+			key += flag ? '1' : '0';
+		key += to_string(m_optimiserSettings.expectedExecutionsPerDeployment);
+		cacheKey = keccak256(key);
+		if (auto bytecode = CompilationCache::get().lookup(cacheKey))
+			return *bytecode;
+	}
+
 	m_compiler.setSources({{"", sourceCode}});
 	m_compiler.setLibraries(_libraryAddresses);
 	m_compiler.setEVMVersion(m_evmVersion);
 	m_compiler.setOptimiserSettings(m_optimiserSettings);
 	m_compiler.enableIRGeneration(m_compileViaYul);
-	if (!m_compiler.compile())
+	bool success = m_compiler.compile();
+	if (!success)
 	{
 		langutil::SourceReferenceFormatter formatter(std::cerr);
 
@@ -72,6 +144,7 @@ bytes SolidityExecutionFramework::compileContract(
 			_contractName.empty() ? m_compiler.lastContractName() : _contractName
 		)))
 		{
+			success = false;
 			langutil::SourceReferenceFormatter formatter(std::cerr);
 
 			for (auto const& error: m_compiler.errors())
@@ -84,5 +157,8 @@ bytes SolidityExecutionFramework::compileContract(
 	else
 		obj = m_compiler.object(_contractName.empty() ? m_compiler.lastContractName() : _contractName);
 	BOOST_REQUIRE(obj.linkReferences.empty());
+	// Failed compilations are not cached so that every test reports its own errors.
+	if (m_useCompilationCache && success)
+		CompilationCache::get().store(cacheKey, obj.bytecode);
 	return obj.bytecode;
 }
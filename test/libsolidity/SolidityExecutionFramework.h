@@ -23,6 +23,11 @@
 #pragma once
 
 #include <functional>
+#include <map>
+#include <mutex>
+#include <ostream>
+
+#include <boost/optional.hpp>
 
 #include <test/ExecutionFramework.h>
 
@@ -41,6 +46,35 @@ namespace solidity
 namespace test
 {
 
+/**
+ * Process-wide cache of the bytecode produced by SolidityExecutionFramework::compileContract.
+ * Many tests compile the same contracts with the same settings again and again, so
+ * the result is stored under a hash of the complete compiler input.
+ */
+class CompilationCache
+{
+public:
+	static CompilationCache& get();
+
+	/// @returns the bytecode stored under @a _key, if any, and updates the statistics.
+	boost::optional<bytes> lookup(h256 const& _key);
+	void store(h256 const& _key, bytes _bytecode);
+
+	/// Prints the number of lookups, hits and cached contracts to @a _stream.
+	void printStatistics(std::ostream& _stream) const;
+
+private:
+	CompilationCache();
+	/// Prints the statistics if requested via the command line.
+	~CompilationCache();
+
+	mutable std::mutex m_mutex;
+	std::map<h256, bytes> m_bytecode;
+	size_t m_lookups = 0;
+	size_t m_hits = 0;
+	bool m_printStatistics = false;
+};
+
 class SolidityExecutionFramework: public dev::test::ExecutionFramework
 {
 
@@ -72,6 +106,10 @@ public:
 protected:
 	dev::solidity::CompilerStack m_compiler;
 	bool m_compileViaYul = false;
+	/// If true, compileContract may return bytecode that was compiled earlier in this
+	/// process for the same input without invoking m_compiler. m_compiler is reset
+	/// in that case, so tests that inspect it after compiling have to disable this.
+	bool m_useCompilationCache = true;
 };
 
 }
@@ -20,9 +20,12 @@
  */
 
 #include <string>
+#include <thread>
 #include <boost/test/unit_test.hpp>
+#include <boost/algorithm/string/replace.hpp>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
+#include <libyul/YulString.h>
 #include <libdevcore/JSON.h>
 #include <test/Metadata.h>
 
@@ -1368,6 +1371,276 @@ BOOST_AUTO_TEST_CASE(standard_output_selection_wildcard_multiple_sources)
 	BOOST_REQUIRE(result["sources"]["B"].isObject());
 }
 
+BOOST_AUTO_TEST_CASE(parallelism_not_a_number)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"parallelism": "4"
+		},
+		"sources": {
+			"empty": {
+				"content": ""
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.parallelism\" must be an unsigned integer."));
+}
+
+BOOST_AUTO_TEST_CASE(parallel_compilation_matches_serial)
+{
+	string input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"parallelism": <PARALLELISM>,
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"*": { "*": ["evm.bytecode", "evm.deployedBytecode", "evm.assembly", "metadata"] }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "import \"fileB\"; contract A { function f() public returns (uint) { return new B().g() + 1; } }"
+			},
+			"fileB": {
+				"content": "contract B { uint x = 7; function g() public view returns (uint) { return x * 3; } }"
+			},
+			"fileC": {
+				"content": "import \"fileB\"; contract C { B b = new B(); function h() public view returns (uint) { return b.g(); } } contract F { function k() public returns (B) { return new B(); } }"
+			},
+			"fileD": {
+				"content": "import \"fileA\"; import \"fileC\"; contract D { A a; C c; constructor() public { a = new A(); c = new C(); } } contract E { function e(uint y) public pure returns (uint) { return y << 3; } }"
+			}
+		}
+	}
+	)";
+	auto compileWithParallelism = [&](string const& _parallelism)
+	{
+		return compile(boost::replace_all_copy(input, "<PARALLELISM>", _parallelism));
+	};
+	Json::Value serial = compileWithParallelism("1");
+	BOOST_REQUIRE(containsAtMostWarnings(serial));
+	BOOST_REQUIRE(serial["contracts"].isObject());
+	BOOST_CHECK_EQUAL(serial["contracts"].size(), 4);
+	// A, C and F create B, so the order in which they optimise its assembly must not change.
+	for (size_t run = 0; run < 5; ++run)
+		for (char const* parallelism: {"0", "2", "3", "8"})
+			BOOST_CHECK_EQUAL(
+				dev::jsonPrettyPrint(compileWithParallelism(parallelism)["contracts"]),
+				dev::jsonPrettyPrint(serial["contracts"])
+			);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_compilers_match_serial)
+{
+	string input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "enabled": <OPTIMIZE>, "details": { "yul": true } },
+			"outputSelection": {
+				"*": { "*": ["evm.bytecode", "evm.deployedBytecode", "evm.assembly", "metadata"] }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "pragma experimental ABIEncoderV2; contract A<ID> { uint[] x; struct S { uint a; bytes b; } function s(S[] memory v) public pure returns (S memory) { return v[0]; } function f(uint a, bytes memory b) public returns (uint, string memory) { x.push(a * <ID>); assembly { a := add(a, mload(b)) } return (x.length + a, \"<ID>\"); } }"
+			},
+			"fileB": {
+				"content": "import \"fileA\"; contract B<ID> { mapping(address => uint8) m; function g() public returns (bytes32) { m[msg.sender] = uint8(<ID>); return keccak256(abi.encode(new A<ID>(), m[msg.sender])); } }"
+			}
+		}
+	}
+	)";
+	vector<string> inputs;
+	for (size_t i = 0; i < 8; ++i)
+		inputs.emplace_back(boost::replace_all_copy(
+			boost::replace_all_copy(input, "<ID>", to_string(i % 4)),
+			"<OPTIMIZE>",
+			i % 2 ? "true" : "false"
+		));
+
+	vector<string> serialResults;
+	for (string const& in: inputs)
+		serialResults.emplace_back(dev::jsonPrettyPrint(compile(in)));
+
+	// Every thread compiles all inputs in a different order, so that the compilations
+	// share the global Yul string repository and the dialect caches in many interleavings.
+	size_t const threadCount = 4;
+	vector<vector<string>> concurrentResults(threadCount, vector<string>(inputs.size()));
+	vector<thread> threads;
+	for (size_t t = 0; t < threadCount; ++t)
+		threads.emplace_back([&, t]() {
+			for (size_t i = 0; i < inputs.size(); ++i)
+			{
+				size_t index = (i + t * 3) % inputs.size();
+				concurrentResults[t][index] = dev::jsonPrettyPrint(compile(inputs[index]));
+			}
+		});
+	for (thread& th: threads)
+		th.join();
+
+	for (size_t i = 0; i < inputs.size(); ++i)
+	{
+		BOOST_REQUIRE(containsAtMostWarnings(compile(inputs[i])));
+		for (size_t t = 0; t < threadCount; ++t)
+			BOOST_CHECK_EQUAL(concurrentResults[t][i], serialResults[i]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(analysis_cache_matches_fresh_compilation)
+{
+	string input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "enabled": <OPTIMIZE> },
+			"outputSelection": {
+				"*": { "*": [<OUTPUTS>], "": ["ast"] }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f() public pure returns (uint) { return <VALUE>; } }"
+			},
+			"fileB": {
+				"content": "import \"fileA\"; contract B is A { function g() public returns (A) { return new A(); } }"
+			}
+		}
+	}
+	)";
+	auto makeInput = [&](string const& _optimize, string const& _outputs, string const& _value)
+	{
+		string result = boost::replace_all_copy(input, "<OPTIMIZE>", _optimize);
+		boost::replace_all(result, "<OUTPUTS>", _outputs);
+		boost::replace_all(result, "<VALUE>", _value);
+		return result;
+	};
+	vector<string> inputs{
+		makeInput("false", "\"abi\"", "1"),
+		makeInput("false", "\"evm.bytecode\", \"evm.assembly\"", "1"),
+		makeInput("false", "\"evm.bytecode\", \"evm.assembly\"", "1"),
+		makeInput("true", "\"evm.bytecode\", \"metadata\"", "1"),
+		makeInput("true", "\"evm.bytecode\", \"metadata\"", "2"),
+		makeInput("true", "\"evm.deployedBytecode\"", "2"),
+		boost::replace_all_copy(makeInput("true", "\"evm.deployedBytecode\"", "2"), "\"*\": {", "\"fileA\": {"),
+		makeInput("true", "\"evm.deployedBytecode\"", "2")
+	};
+
+	vector<string> expectations;
+	for (string const& in: inputs)
+	{
+		Json::Value result = compile(in);
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+		expectations.emplace_back(dev::jsonCompactPrint(result));
+	}
+
+	// No other compiler stack may be used while the cache is enabled, so the expectations
+	// are computed beforehand.
+	solidity::StandardCompiler compiler;
+	compiler.enableAnalysisCache();
+	for (size_t i = 0; i < inputs.size(); ++i)
+	{
+		Json::Value result;
+		BOOST_REQUIRE(jsonParseStrict(compiler.compile(inputs[i]), result));
+		BOOST_CHECK_EQUAL(dev::jsonCompactPrint(result), expectations[i]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(incremental_analysis_matches_fresh_compilation)
+{
+	string const lib =
+		"pragma experimental ABIEncoderV2;"
+		"library L { struct S { uint a; uint[] b; } function sum(S memory s) internal pure returns (uint) { return s.a + s.b.length; } }";
+	string const a =
+		"pragma experimental ABIEncoderV2; import \"lib.sol\";"
+		"contract A { function f(L.S memory s) public pure returns (uint) { uint unused; return L.sum(s); } }";
+	string const b = "contract B { function g() public view returns (uint) { return <VALUE>; } }";
+	string const c = "import {B as Base} from \"b.sol\"; contract C is Base { function h() public returns (Base) { return new Base(); } }";
+	auto makeInput = [](map<string, string> const& _sources)
+	{
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["settings"]["outputSelection"]["*"]["*"].append("abi");
+		input["settings"]["outputSelection"]["*"]["*"].append("evm.bytecode.object");
+		input["settings"]["outputSelection"]["*"][""].append("ast");
+		for (auto const& source: _sources)
+			input["sources"][source.first]["content"] = source.second;
+		return dev::jsonCompactPrint(input);
+	};
+	auto withValue = [](string const& _source, string const& _value)
+	{
+		return boost::replace_all_copy(_source, "<VALUE>", _value);
+	};
+	string const changedA = boost::replace_all_copy(a, "contract A {", "contract A { function e() public {}");
+	vector<string> inputs{
+		makeInput({{"lib.sol", lib}, {"a.sol", a}, {"b.sol", withValue(b, "1")}, {"c.sol", c}}),
+		// Only c.sol has to be analysed again.
+		makeInput({{"lib.sol", lib}, {"a.sol", a}, {"b.sol", withValue(b, "block.number")}, {"c.sol", c}}),
+		// The nodes of b.sol and c.sol receive new IDs.
+		makeInput({{"lib.sol", lib}, {"a.sol", changedA}, {"b.sol", withValue(b, "block.number")}, {"c.sol", c}}),
+		makeInput({{"lib.sol", lib}, {"a.sol", changedA}, {"b.sol", withValue(b, "1 +")}, {"c.sol", c}}),
+		makeInput({{"lib.sol", lib}, {"a.sol", changedA}, {"b.sol", withValue(b, "2")}, {"c.sol", c}}),
+		makeInput({{"a.sol", changedA}, {"b.sol", withValue(b, "2")}, {"c.sol", c}}),
+		makeInput({{"lib.sol", lib}, {"a.sol", a}, {"b.sol", withValue(b, "2")}, {"c.sol", c}, {"d.sol", "import \"a.sol\"; contract D { function k(A _a) public pure returns (A) { return _a; } }"}}),
+		makeInput({{"lib.sol", lib}, {"a.sol", a}, {"b.sol", withValue(b, "2")}, {"c.sol", c}}),
+		makeInput({{"lib.sol", lib}, {"a.sol", a}, {"b.sol", withValue(b, "2")}, {"c.sol", c}})
+	};
+
+	vector<string> expectations;
+	for (string const& in: inputs)
+		expectations.emplace_back(dev::jsonCompactPrint(compile(in)));
+
+	solidity::StandardCompiler compiler;
+	compiler.enableAnalysisCache();
+	for (size_t i = 0; i < inputs.size(); ++i)
+	{
+		Json::Value result;
+		BOOST_REQUIRE(jsonParseStrict(compiler.compile(inputs[i]), result));
+		BOOST_CHECK_EQUAL(dev::jsonCompactPrint(result), expectations[i]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(analysis_cache_bounds_yul_strings)
+{
+	// Every input introduces new Yul identifiers.
+	auto makeInput = [](size_t _index)
+	{
+		string body;
+		for (size_t i = 0; i < 50; ++i)
+			body += "let x_" + to_string(_index) + "_" + to_string(i) + " := " + to_string(i) + " ";
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["settings"]["outputSelection"]["*"]["*"].append("evm.bytecode.object");
+		input["sources"]["a.sol"]["content"] = "contract C { function f() public pure { assembly { " + body + "} } }";
+		return dev::jsonCompactPrint(input);
+	};
+	string const lastInput = makeInput(99);
+	string const expectation = dev::jsonCompactPrint(compile(lastInput));
+
+	size_t constexpr maxYulStrings = 2000;
+	size_t largestRepository = 0;
+	solidity::StandardCompiler compiler;
+	compiler.enableAnalysisCache(true, maxYulStrings);
+	for (size_t i = 0; i < 100; ++i)
+	{
+		Json::Value result;
+		BOOST_REQUIRE(jsonParseStrict(compiler.compile(makeInput(i)), result));
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+		largestRepository = max(largestRepository, yul::YulStringRepository::instance().size());
+	}
+	// Without a reset, the 5000 identifiers of all inputs would be kept.
+	BOOST_CHECK_LT(largestRepository, maxYulStrings + 1000);
+
+	Json::Value result;
+	BOOST_REQUIRE(jsonParseStrict(compiler.compile(lastInput), result));
+	BOOST_CHECK_EQUAL(dev::jsonCompactPrint(result), expectation);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
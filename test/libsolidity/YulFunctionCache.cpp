@@ -0,0 +1,138 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Tests for sharing generated Yul functions between contracts.
+ */
+
+#include <libsolidity/codegen/ABIFunctions.h>
+#include <libsolidity/codegen/MultiUseYulFunctionCollector.h>
+#include <libsolidity/codegen/YulFunctionCache.h>
+#include <libsolidity/ast/TypeProvider.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace langutil;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+/// @returns a creator for function @a _name that requests @a _dependencies from @a _collector.
+function<string()> creator(
+	MultiUseYulFunctionCollector& _collector,
+	string const& _name,
+	vector<pair<string, function<string()>>> const& _dependencies = {}
+)
+{
+	return [&_collector, _name, _dependencies]() {
+		string body;
+		for (auto const& dependency: _dependencies)
+			body += _collector.createFunction(dependency.first, dependency.second) + "() ";
+		return "function " + _name + "() { " + body + "}\n";
+	};
+}
+
+function<string()> unexpectedCreator(string const& _name)
+{
+	return [=]() -> string {
+		BOOST_ERROR("Function " + _name + " was created again.");
+		return "function " + _name + "() {}\n";
+	};
+}
+
+/// @returns the code of the ABI functions for the signatures of a contract.
+pair<string, set<string>> abiFunctions(shared_ptr<YulFunctionCache> _cache, bool _withArrays)
+{
+	ABIFunctions functions(EVMVersion{}, make_shared<MultiUseYulFunctionCollector>(_cache));
+	TypePointers types{TypeProvider::uint256(), TypeProvider::bytesMemory()};
+	if (_withArrays)
+		types.push_back(TypeProvider::array(DataLocation::Memory, TypeProvider::uint(8)));
+	functions.tupleEncoder(types, types);
+	functions.tupleDecoder(types, true);
+	functions.tupleDecoder({TypeProvider::stringMemory()});
+	return functions.requestedFunctions();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulFunctionCacheTest)
+
+BOOST_AUTO_TEST_CASE(dependencies_of_cached_functions)
+{
+	auto cache = make_shared<YulFunctionCache>(EVMVersion{});
+
+	MultiUseYulFunctionCollector first(cache);
+	first.createFunction("f", creator(first, "f", {
+		{"g", creator(first, "g", {{"h", creator(first, "h")}})},
+		{"i", creator(first, "i")}
+	}));
+	first.createFunction("unrelated", creator(first, "unrelated"));
+	string firstCode = first.requestedFunctions();
+
+	// The second collector takes f from the cache, but still needs all functions called by f.
+	MultiUseYulFunctionCollector second(cache);
+	second.createFunction("f", unexpectedCreator("f"));
+	string secondCode = second.requestedFunctions();
+	BOOST_CHECK_EQUAL(
+		secondCode,
+		"function f() { g() i() }\n"
+		"function g() { h() }\n"
+		"function h() { }\n"
+		"function i() { }\n"
+	);
+	BOOST_CHECK_EQUAL(firstCode, secondCode + "function unrelated() { }\n");
+
+	// Dependencies are also added if the cached function is requested while creating another one.
+	MultiUseYulFunctionCollector third(cache);
+	third.createFunction("j", creator(third, "j", {{"g", unexpectedCreator("g")}}));
+	BOOST_CHECK_EQUAL(
+		third.requestedFunctions(),
+		"function g() { h() }\n"
+		"function h() { }\n"
+		"function j() { g() }\n"
+	);
+	BOOST_REQUIRE(cache->function("j"));
+	BOOST_CHECK(cache->function("j")->dependencies == vector<string>{"g"});
+}
+
+BOOST_AUTO_TEST_CASE(same_code_with_and_without_cache)
+{
+	auto cache = make_shared<YulFunctionCache>(EVMVersion{});
+	// Fill the cache with the functions of another contract that shares some of them.
+	abiFunctions(cache, false);
+	for (bool withArrays: {false, true})
+	{
+		auto cached = abiFunctions(cache, withArrays);
+		auto uncached = abiFunctions(nullptr, withArrays);
+		BOOST_CHECK(!uncached.first.empty());
+		BOOST_CHECK_EQUAL(cached.first, uncached.first);
+		BOOST_CHECK(cached.second == uncached.second);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+} // end namespaces
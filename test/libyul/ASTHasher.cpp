@@ -0,0 +1,107 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the hashes used to detect changes by the optimiser suite.
+ */
+
+#include <test/Options.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/AsmData.h>
+
+
+using namespace std;
+using namespace langutil;
+
+namespace yul
+{
+namespace test
+{
+
+namespace
+{
+
+uint64_t hash(string const& _source)
+{
+	return ASTHasher::run(disambiguate(_source, false));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulASTHasher)
+
+BOOST_AUTO_TEST_CASE(equal_code)
+{
+	BOOST_CHECK_EQUAL(hash("{ let x := mload(0) sstore(x, 1) }"), hash("{ let x := mload(0) sstore(x, 1) }"));
+}
+
+BOOST_AUTO_TEST_CASE(variable_names_are_ignored)
+{
+	BOOST_CHECK_EQUAL(
+		hash("{ function f(a) -> b { b := a } let x := f(2) }"),
+		hash("{ function f(c) -> d { d := c } let y := f(2) }")
+	);
+}
+
+BOOST_AUTO_TEST_CASE(variable_order)
+{
+	BOOST_CHECK(hash("{ let a let b sstore(a, b) }") != hash("{ let a let b sstore(b, a) }"));
+}
+
+BOOST_AUTO_TEST_CASE(function_names)
+{
+	BOOST_CHECK(hash("{ function f() {} f() }") != hash("{ function g() {} g() }"));
+}
+
+BOOST_AUTO_TEST_CASE(literals)
+{
+	BOOST_CHECK(hash("{ sstore(0, 1) }") != hash("{ sstore(0, 2) }"));
+	BOOST_CHECK(hash("{ sstore(0, 1) }") != hash("{ sstore(1, 0) }"));
+}
+
+BOOST_AUTO_TEST_CASE(nested_blocks)
+{
+	BOOST_CHECK(hash("{ { sstore(0, 1) } }") != hash("{ sstore(0, 1) }"));
+	BOOST_CHECK(hash("{ { } { } }") != hash("{ { { } } }"));
+}
+
+BOOST_AUTO_TEST_CASE(switch_case_order)
+{
+	BOOST_CHECK(
+		hash("{ switch calldatasize() case 0 { sstore(0, 1) } case 1 { sstore(1, 1) } }") !=
+		hash("{ switch calldatasize() case 1 { sstore(1, 1) } case 0 { sstore(0, 1) } }")
+	);
+	BOOST_CHECK(
+		hash("{ switch calldatasize() case 0 { } default { } }") !=
+		hash("{ switch calldatasize() case 0 { } }")
+	);
+}
+
+BOOST_AUTO_TEST_CASE(for_loop)
+{
+	BOOST_CHECK(
+		hash("{ for { let i := 0 } lt(i, 2) { i := add(i, 1) } { } }") !=
+		hash("{ for { let i := 0 } lt(i, 2) { } { i := add(i, 1) } }")
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
@@ -0,0 +1,166 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the concurrent parts of the optimiser suite.
+ */
+
+#include <test/Options.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/Suite.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/AsmData.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AssemblyStack.h>
+#include <libyul/Object.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <set>
+
+using namespace std;
+using namespace langutil;
+
+namespace yul
+{
+namespace test
+{
+
+namespace
+{
+
+EVMDialect const& dialect()
+{
+	return EVMDialect::strictAssemblyForEVM(dev::test::Options::get().evmVersion());
+}
+
+string optimise(string const& _source, size_t _threads)
+{
+	auto parsed = parse(_source, false);
+	BOOST_REQUIRE(parsed.first);
+	GasMeter meter(dialect(), false, 200);
+	Object object;
+	object.code = parsed.first;
+	object.analysisInfo = parsed.second;
+	OptimiserSuite::run(dialect(), &meter, object, true, {}, nullptr, _threads);
+	return AsmPrinter{}(*object.code);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulOptimiserSuite)
+
+BOOST_AUTO_TEST_CASE(concurrent_name_dispensers)
+{
+	Block ast = disambiguate("{ let x let x_1 let y_2 }", false);
+	NameDispenser dispenser(dialect(), ast);
+
+	vector<NameDispenser> tasks;
+	for (size_t i = 0; i < 3; ++i)
+		tasks.emplace_back(dispenser.concurrentTask(i, 3));
+	// Requests in a different order have to return the same names.
+	vector<YulString> lastTaskNames{tasks[2].newName(YulString{"y"}), tasks[2].newName(YulString{"x"})};
+
+	set<YulString> names;
+	for (size_t i = 0; i < 3; ++i)
+		for (string hint: {"x", "y", "z"})
+		{
+			YulString name = tasks[i].newName(YulString{hint});
+			BOOST_CHECK(!names.count(name));
+			BOOST_CHECK(name.str() != hint);
+			names.insert(name);
+		}
+	for (YulString used: {YulString{"x"}, YulString{"x_1"}, YulString{"y_2"}})
+		BOOST_CHECK(!names.count(used));
+
+	NameDispenser otherTask = dispenser.concurrentTask(2, 3);
+	BOOST_CHECK(otherTask.newName(YulString{"y"}) == lastTaskNames[0]);
+	BOOST_CHECK(otherTask.newName(YulString{"x"}) == lastTaskNames[1]);
+
+	for (auto const& task: tasks)
+		dispenser.join(task);
+	for (YulString name: names)
+		BOOST_CHECK(dispenser.newName(name) != name);
+}
+
+BOOST_AUTO_TEST_CASE(result_does_not_depend_on_threads)
+{
+	string const source = R"({
+		function sum(a, b) -> r {
+			for { let i := 0 } lt(i, a) { i := add(i, 1) } {
+				r := add(r, mload(add(b, mul(i, 0x20))))
+			}
+		}
+		function g(x) -> y {
+			y := sum(x, mload(0x40))
+			if gt(y, 10) { y := sum(y, calldataload(y)) }
+			switch y
+			case 0 { y := sload(y) }
+			default { y := mul(y, y) }
+		}
+		function h(p) {
+			sstore(p, g(sload(p)))
+			sstore(add(p, 1), g(calldataload(p)))
+		}
+		h(calldataload(0))
+		h(calldataload(32))
+		sstore(0, g(3))
+	})";
+	string const expectation = optimise(source, 1);
+	for (size_t threads: {2, 4, 16})
+		BOOST_CHECK_EQUAL(optimise(source, threads), expectation);
+}
+
+BOOST_AUTO_TEST_CASE(corpus_result_does_not_depend_on_threads)
+{
+	size_t sources = 0;
+	for (char const* corpus: {"yulOptimizerTests/fullSuite", "yulInterpreterTests"})
+		for (auto const& entry: boost::filesystem::directory_iterator(dev::test::Options::get().testPath / "libyul" / corpus))
+		{
+			ifstream file(entry.path().string());
+			string source{istreambuf_iterator<char>(file), istreambuf_iterator<char>()};
+			source = source.substr(0, source.find("\n// ----"));
+			// Objects are not supported by the dialect.
+			if (boost::starts_with(source, "object"))
+				continue;
+			AssemblyStack stack(
+				dev::test::Options::get().evmVersion(),
+				AssemblyStack::Language::StrictAssembly,
+				dev::solidity::OptimiserSettings::none()
+			);
+			if (!stack.parseAndAnalyze("", source) || !stack.errors().empty())
+				continue;
+			BOOST_TEST_MESSAGE(entry.path().string());
+			string const expectation = optimise(source, 1);
+			for (size_t threads: {2, 3})
+				BOOST_CHECK_EQUAL(optimise(source, threads), expectation);
+			++sources;
+		}
+	BOOST_CHECK(sources > 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
@@ -0,0 +1,169 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the paged memory of the Yul interpreter.
+ */
+
+#include <test/tools/yulInterpreter/Interpreter.h>
+#include <test/tools/yulInterpreter/PagedMemory.h>
+
+#include <libdevcore/FixedHash.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+using namespace dev;
+
+namespace yul
+{
+namespace test
+{
+
+namespace
+{
+
+u256 const c_value("0x0102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20");
+u256 const c_maxOffset = ~u256(0);
+
+/// @returns the memory dump in the format used when the memory was a map from offsets to bytes.
+string legacyMemoryDump(map<u256, uint8_t> const& _memory)
+{
+	ostringstream out;
+	out << "Trace:" << endl;
+	out << "Memory dump:\n";
+	map<u256, u256> words;
+	for (auto const& [offset, value]: _memory)
+		words[(offset / 0x20) * 0x20] |= u256(uint32_t(value)) << (256 - 8 - 8 * size_t(offset % 0x20));
+	for (auto const& [offset, value]: words)
+		if (value != 0)
+			out << "  " << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << endl;
+	out << "Storage dump:" << endl;
+	return out.str();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulPagedMemory)
+
+BOOST_AUTO_TEST_CASE(unwritten_memory_is_zero)
+{
+	PagedMemory memory;
+	BOOST_CHECK_EQUAL(memory.byte(0x1234), 0);
+	BOOST_CHECK_EQUAL(memory.word(PagedMemory::pageSize - 1), 0);
+	BOOST_CHECK(memory.read(c_maxOffset, 64) == bytes(64, 0));
+	BOOST_CHECK(memory.pages().empty());
+}
+
+BOOST_AUTO_TEST_CASE(word_crossing_page_boundary)
+{
+	PagedMemory memory;
+	u256 const offset = 2 * PagedMemory::pageSize - 5;
+	memory.setWord(offset, c_value);
+	BOOST_CHECK_EQUAL(memory.pages().size(), 2);
+	BOOST_CHECK_EQUAL(memory.word(offset), c_value);
+	for (size_t i = 0; i < 32; ++i)
+		BOOST_CHECK_EQUAL(memory.byte(offset + i), i + 1);
+	BOOST_CHECK_EQUAL(memory.byte(offset - 1), 0);
+	BOOST_CHECK_EQUAL(memory.byte(offset + 32), 0);
+	BOOST_CHECK_EQUAL(memory.word(offset + 1), c_value << 8);
+	BOOST_CHECK_EQUAL(memory.word(offset - 1), c_value >> 8);
+
+	bytes data = memory.read(offset - 1, 34);
+	BOOST_CHECK_EQUAL(data.front(), 0);
+	BOOST_CHECK(bytes(data.begin() + 1, data.end() - 1) == h256(c_value).asBytes());
+	BOOST_CHECK_EQUAL(data.back(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(write_zero_extended_crossing_page_boundary)
+{
+	PagedMemory memory;
+	u256 const offset = PagedMemory::pageSize - 2;
+	memory.setWord(offset, ~u256(0));
+	memory.writeZeroExtended(offset, bytes{1, 2, 3, 4}, 1, 8);
+	BOOST_CHECK(memory.read(offset, 10) == (bytes{2, 3, 4, 0, 0, 0, 0, 0, 0xff, 0xff}));
+}
+
+BOOST_AUTO_TEST_CASE(access_wraps_around)
+{
+	PagedMemory memory;
+	u256 const offset = c_maxOffset - 15;
+	memory.setWord(offset, c_value);
+	BOOST_CHECK_EQUAL(memory.word(offset), c_value);
+	// The second half of the word is stored at the start of the memory.
+	for (size_t i = 0; i < 16; ++i)
+	{
+		BOOST_CHECK_EQUAL(memory.byte(offset + i), i + 1);
+		BOOST_CHECK_EQUAL(memory.byte(i), i + 17);
+	}
+	BOOST_CHECK_EQUAL(memory.byte(16), 0);
+	BOOST_REQUIRE_EQUAL(memory.pages().size(), 2);
+	BOOST_CHECK_EQUAL(memory.pages().begin()->first, 0);
+	BOOST_CHECK_EQUAL(memory.pages().rbegin()->first, c_maxOffset / PagedMemory::pageSize);
+
+	memory.setByte(c_maxOffset, 0xab);
+	BOOST_CHECK(memory.read(c_maxOffset, 2) == (bytes{0xab, 17}));
+}
+
+BOOST_AUTO_TEST_CASE(dump_skips_zero_pages)
+{
+	InterpreterState state;
+	// Allocates pages, but only with zeros.
+	state.memory.setWord(0x5000, 0);
+	state.memory.setByte(c_maxOffset, 0);
+	state.memory.setWord(0x2040, 7);
+	BOOST_CHECK_EQUAL(state.memory.pages().size(), 3);
+
+	ostringstream dump;
+	state.dumpTraceAndState(dump);
+	BOOST_CHECK_EQUAL(
+		dump.str(),
+		"Trace:\n"
+		"Memory dump:\n"
+		"  2040: 0000000000000000000000000000000000000000000000000000000000000007\n"
+		"Storage dump:\n"
+	);
+}
+
+BOOST_AUTO_TEST_CASE(dump_matches_legacy_format)
+{
+	InterpreterState state;
+	map<u256, uint8_t> legacyMemory;
+	auto store = [&](u256 const& _offset, bytes const& _data)
+	{
+		state.memory.writeZeroExtended(_offset, _data, 0, _data.size());
+		for (size_t i = 0; i < _data.size(); ++i)
+			legacyMemory[u256(_offset + i)] = _data[i];
+	};
+	store(0, h256(c_value).asBytes());
+	store(0x45, bytes{0, 0xff, 0});
+	store(PagedMemory::pageSize - 7, h256(c_value).asBytes());
+	store(0x123456789, bytes{1, 2, 3});
+	store(c_maxOffset - 40, bytes(30, 0x11));
+	store(0x300, bytes(64, 0));
+
+	ostringstream dump;
+	state.dumpTraceAndState(dump);
+	BOOST_CHECK_EQUAL(dump.str(), legacyMemoryDump(legacyMemory));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
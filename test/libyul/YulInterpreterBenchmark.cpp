@@ -0,0 +1,129 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Benchmark of the Yul interpreters on the yulInterpreterTests corpus.
+ * It is disabled by default, run it with
+ * soltest -t YulInterpreterBenchmark -- --testpath <path to test>
+ */
+
+#include <test/tools/yulInterpreter/Interpreter.h>
+#include <test/tools/yulInterpreter/SlotInterpreter.h>
+
+#include <test/Options.h>
+
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AssemblyStack.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+
+using namespace std;
+using namespace dev;
+
+namespace yul
+{
+namespace test
+{
+
+namespace
+{
+
+/// @returns the parsed sources of all test cases in the interpreter test corpus.
+vector<shared_ptr<Block>> corpus()
+{
+	vector<shared_ptr<Block>> programs;
+	boost::filesystem::path directory = dev::test::Options::get().testPath / "libyul" / "yulInterpreterTests";
+	for (auto const& entry: boost::filesystem::directory_iterator(directory))
+	{
+		ifstream file(entry.path().string());
+		string source{istreambuf_iterator<char>(file), istreambuf_iterator<char>()};
+		source = source.substr(0, source.find("\n// ----"));
+		AssemblyStack stack(
+			dev::test::Options::get().evmVersion(),
+			AssemblyStack::Language::StrictAssembly,
+			dev::solidity::OptimiserSettings::none()
+		);
+		BOOST_REQUIRE_MESSAGE(stack.parseAndAnalyze("", source), entry.path().string());
+		programs.emplace_back(stack.parserResult()->code);
+	}
+	return programs;
+}
+
+/// Runs every program with @a _run, using the same limits as the interpreter tests, and repeats
+/// the corpus for at least a second.
+void measure(string const& _engine, size_t _programs, function<void(size_t, InterpreterState&)> const& _run)
+{
+	size_t steps = 0;
+	size_t runs = 0;
+	auto start = chrono::steady_clock::now();
+	chrono::duration<double> elapsed{0};
+	for (; elapsed < chrono::seconds(1); elapsed = chrono::steady_clock::now() - start)
+		for (size_t i = 0; i < _programs; ++i)
+		{
+			InterpreterState state;
+			state.maxTraceSize = 10000;
+			state.maxSteps = 10000;
+			try
+			{
+				_run(i, state);
+			}
+			catch (InterpreterTerminatedGeneric const&)
+			{
+			}
+			steps += state.numSteps;
+			++runs;
+		}
+
+	cout <<
+		_engine << ": interpreted " << runs << " programs with " << steps << " steps in " << elapsed.count() << "s: " <<
+		size_t(steps / elapsed.count()) << " steps/s" << endl;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulInterpreterBenchmark, *boost::unit_test::disabled())
+
+BOOST_AUTO_TEST_CASE(steps_per_second)
+{
+	vector<shared_ptr<Block>> programs = corpus();
+	BOOST_REQUIRE(!programs.empty());
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion{});
+
+	measure("Interpreter", programs.size(), [&](size_t _program, InterpreterState& _state) {
+		Interpreter interpreter(_state, dialect);
+		interpreter(*programs[_program]);
+	});
+
+	// The code is lowered once, like yulrun and the fuzzers do.
+	vector<SlotInterpreter> lowered;
+	for (auto const& program: programs)
+		lowered.emplace_back(dialect, *program);
+	measure("SlotInterpreter", programs.size(), [&](size_t _program, InterpreterState& _state) {
+		lowered[_program].run(_state);
+	});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
@@ -18,6 +18,7 @@
 #include <test/libyul/YulInterpreterTest.h>
 
 #include <test/tools/yulInterpreter/Interpreter.h>
+#include <test/tools/yulInterpreter/SlotInterpreter.h>
 
 #include <test/Options.h>
 
@@ -74,6 +75,16 @@ TestCase::TestResult YulInterpreterTest::run(ostream& _stream, string const& _li
 		printIndented(_stream, m_obtainedResult, nextIndentLevel);
 		return TestResult::Failure;
 	}
+
+	string loweredResult = interpret(true);
+	if (loweredResult != m_obtainedResult)
+	{
+		string nextIndentLevel = _linePrefix + "  ";
+		AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::CYAN}) << _linePrefix << "Result of the slot interpreter:" << endl;
+		printIndented(_stream, loweredResult, nextIndentLevel);
+		AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED}) << _linePrefix << "It differs from the result of the interpreter." << endl;
+		return TestResult::Failure;
+	}
 	return TestResult::Success;
 }
 
@@ -116,15 +127,21 @@ bool YulInterpreterTest::parse(ostream& _stream, string const& _linePrefix, bool
 	}
 }
 
-string YulInterpreterTest::interpret()
+string YulInterpreterTest::interpret(bool _lowered)
 {
 	InterpreterState state;
 	state.maxTraceSize = 10000;
 	state.maxSteps = 10000;
-	Interpreter interpreter(state, EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion{}));
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion{});
 	try
 	{
-		interpreter(*m_ast);
+		if (_lowered)
+			SlotInterpreter(dialect, *m_ast).run(state);
+		else
+		{
+			Interpreter interpreter(state, dialect);
+			interpreter(*m_ast);
+		}
 	}
 	catch (InterpreterTerminatedGeneric const&)
 	{
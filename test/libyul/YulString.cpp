@@ -0,0 +1,107 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the Yul string repository.
+ */
+
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <future>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace yul
+{
+namespace test
+{
+
+namespace
+{
+
+vector<string> testStrings(size_t _count)
+{
+	vector<string> strings;
+	for (size_t i = 0; i < _count; ++i)
+		strings.emplace_back("yul_string_test_" + to_string(i));
+	return strings;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulStringRepositoryTest)
+
+BOOST_AUTO_TEST_CASE(interning)
+{
+	BOOST_CHECK(YulString{} == YulString{""});
+	BOOST_CHECK(YulString{""}.empty());
+	BOOST_CHECK_EQUAL(YulString{""}.hash(), YulStringRepository::emptyHash());
+
+	YulString a{"abc"};
+	BOOST_CHECK(a == YulString{"abc"});
+	BOOST_CHECK(a != YulString{"abd"});
+	BOOST_CHECK_EQUAL(a.str(), "abc");
+	BOOST_CHECK_EQUAL(a.hash(), YulStringRepository::hash("abc"));
+}
+
+BOOST_AUTO_TEST_CASE(many_strings)
+{
+	vector<string> strings = testStrings(20000);
+	vector<YulString> interned;
+	for (string const& s: strings)
+		interned.emplace_back(s);
+	for (size_t i = 0; i < strings.size(); ++i)
+	{
+		BOOST_CHECK_EQUAL(interned[i].str(), strings[i]);
+		BOOST_CHECK(YulString{strings[i]} == interned[i]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	vector<string> const strings = testStrings(10000);
+	vector<future<vector<YulString>>> results;
+	for (size_t thread = 0; thread < 4; ++thread)
+		results.emplace_back(async(launch::async, [&, thread]() {
+			// Every thread interns the strings in a different order.
+			vector<YulString> interned(strings.size());
+			for (size_t i = 0; i < strings.size(); ++i)
+			{
+				size_t index = (i * 7919 + thread * 1013) % strings.size();
+				interned[index] = YulString{strings[index]};
+			}
+			return interned;
+		}));
+
+	vector<vector<YulString>> interned;
+	for (auto& result: results)
+		interned.emplace_back(result.get());
+	for (size_t i = 0; i < strings.size(); ++i)
+	{
+		BOOST_CHECK_EQUAL(interned[0][i].str(), strings[i]);
+		for (size_t thread = 1; thread < interned.size(); ++thread)
+			BOOST_CHECK(interned[thread][i] == interned[0][i]);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
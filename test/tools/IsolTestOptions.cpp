@@ -59,6 +59,7 @@ IsolTestOptions::IsolTestOptions(std::string* _editor):
 		("editor", po::value<std::string>(_editor)->default_value(editorPath()), "Path to editor for opening test files.")
 		("help", po::bool_switch(&showHelp), "Show this help screen.")
 		("no-color", po::bool_switch(&noColor), "Don't use colors.")
+		("jobs,j", po::value<unsigned>(&jobs)->value_name("n")->default_value(1), "Run up to n test cases concurrently. Failed test cases are run again and handled one after the other. Zero uses the number of hardware threads.")
 		("test,t", po::value<std::string>(&testFilter)->default_value("*/*"), "Filters which test units to include.");
 }
 
@@ -17,6 +17,7 @@
 
 #include <libdevcore/CommonIO.h>
 #include <libdevcore/AnsiColorized.h>
+#include <libdevcore/ThreadPool.h>
 
 #include <test/Common.h>
 #include <test/tools/IsolTestOptions.h>
@@ -29,11 +30,14 @@
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
+#include <atomic>
 #include <cstdlib>
+#include <future>
 #include <iostream>
 #include <fstream>
 #include <queue>
 #include <regex>
+#include <sstream>
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -112,7 +116,8 @@ public:
 		Skipped
 	};
 
-	Result process();
+	/// Runs the test case and prints its progress and, if it fails, the details to @a _stream.
+	Result process(ostream& _stream);
 
 	static TestStats processPath(
 		TestCreator _testCaseCreator,
@@ -140,13 +145,22 @@ private:
 
 	unique_ptr<TestCase> m_test;
 
-	static bool m_exitRequested;
+	/// Runs the test case at @a _path in a separate TestTool and @returns the result
+	/// and the output, so that tests can be run by worker threads.
+	static pair<Result, string> runBuffered(
+		TestCreator _testCaseCreator,
+		TestOptions const& _options,
+		fs::path const& _path,
+		string const& _name
+	);
+
+	static atomic<bool> m_exitRequested;
 };
 
 string TestTool::editor;
-bool TestTool::m_exitRequested = false;
+atomic<bool> TestTool::m_exitRequested{false};
 
-TestTool::Result TestTool::process()
+TestTool::Result TestTool::process(ostream& _stream)
 {
 	bool formatted{!m_options.noColor};
 	std::stringstream outputMessages;
@@ -155,28 +169,28 @@ TestTool::Result TestTool::process()
 	{
 		if (m_filter.matches(m_name))
 		{
-			(AnsiColorized(cout, formatted, {BOLD}) << m_name << ": ").flush();
+			(AnsiColorized(_stream, formatted, {BOLD}) << m_name << ": ").flush();
 
 			m_test = m_testCaseCreator(TestCase::Config{m_path.string(), m_options.evmVersion()});
 			if (m_test->validateSettings(m_options.evmVersion()))
 				switch (TestCase::TestResult result = m_test->run(outputMessages, "  ", formatted))
 				{
 					case TestCase::TestResult::Success:
-						AnsiColorized(cout, formatted, {BOLD, GREEN}) << "OK" << endl;
+						AnsiColorized(_stream, formatted, {BOLD, GREEN}) << "OK" << endl;
 						return Result::Success;
 					default:
-						AnsiColorized(cout, formatted, {BOLD, RED}) << "FAIL" << endl;
+						AnsiColorized(_stream, formatted, {BOLD, RED}) << "FAIL" << endl;
 
-						AnsiColorized(cout, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
-						m_test->printSource(cout, "    ", formatted);
-						m_test->printUpdatedSettings(cout, "    ", formatted);
+						AnsiColorized(_stream, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
+						m_test->printSource(_stream, "    ", formatted);
+						m_test->printUpdatedSettings(_stream, "    ", formatted);
 
-						cout << endl << outputMessages.str() << endl;
+						_stream << endl << outputMessages.str() << endl;
 						return result == TestCase::TestResult::FatalError ? Result::Exception : Result::Failure;
 				}
 			else
 			{
-				AnsiColorized(cout, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
+				AnsiColorized(_stream, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
 				return Result::Skipped;
 			}
 		}
@@ -185,13 +199,13 @@ TestTool::Result TestTool::process()
 	}
 	catch (boost::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Exception during test: " << boost::diagnostic_information(_e) << endl;
 		return Result::Exception;
 	}
 	catch (std::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Exception during test" <<
 			(_e.what() ? ": " + string(_e.what()) : ".") <<
 			endl;
@@ -199,7 +213,7 @@ TestTool::Result TestTool::process()
 	}
 	catch (...)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Unknown exception during test." << endl;
 		return Result::Exception;
 	}
@@ -247,6 +261,21 @@ TestTool::Request TestTool::handleResponse(bool _exception)
 	}
 }
 
+pair<TestTool::Result, string> TestTool::runBuffered(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	fs::path const& _path,
+	string const& _name
+)
+{
+	if (m_exitRequested)
+		return {Result::Skipped, {}};
+	ostringstream output;
+	TestTool testTool(_testCaseCreator, _options, _path, _name);
+	Result result = testTool.process(output);
+	return {result, output.str()};
+}
+
 TestStats TestTool::processPath(
 	TestCreator _testCaseCreator,
 	TestOptions const& _options,
@@ -256,18 +285,15 @@ TestStats TestTool::processPath(
 {
 	std::queue<fs::path> paths;
 	paths.push(_path);
-	int successCount = 0;
-	int testCount = 0;
-	int skippedCount = 0;
-
+	vector<fs::path> testPaths;
 	while (!paths.empty())
 	{
 		auto currentPath = paths.front();
+		paths.pop();
 
 		fs::path fullpath = _basepath / currentPath;
 		if (fs::is_directory(fullpath))
 		{
-			paths.pop();
 			for (auto const& entry: boost::iterator_range<fs::directory_iterator>(
 				fs::directory_iterator(fullpath),
 				fs::directory_iterator()
@@ -275,21 +301,65 @@ TestStats TestTool::processPath(
 				if (fs::is_directory(entry.path()) || TestCase::isTestFilename(entry.path().filename()))
 					paths.push(currentPath / entry.path().filename());
 		}
-		else if (m_exitRequested)
+		else
+			testPaths.push_back(currentPath);
+	}
+
+	// With more than one job, all test cases are run in advance by a pool of worker threads.
+	// Their output is printed in the original order. Test cases that fail are run again
+	// in this thread, so that the interaction with the user stays the same. Every test case
+	// is created and destroyed by the same thread, since the compiler uses per-thread state.
+	unique_ptr<ThreadPool> threadPool;
+	vector<future<pair<Result, string>>> bufferedResults;
+	if (_options.jobs != 1)
+	{
+		threadPool = make_unique<ThreadPool>(_options.jobs == 0 ? ThreadPool::hardwareConcurrency() : _options.jobs);
+		for (fs::path const& testPath: testPaths)
+			bufferedResults.emplace_back(threadPool->submit([=, &_options]() {
+				return runBuffered(_testCaseCreator, _options, _basepath / testPath, testPath.generic_path().string());
+			}));
+	}
+
+	int successCount = 0;
+	int testCount = 0;
+	int skippedCount = 0;
+
+	size_t index = 0;
+	while (index < testPaths.size())
+	{
+		auto const& currentPath = testPaths[index];
+		fs::path fullpath = _basepath / currentPath;
+		if (m_exitRequested)
 		{
 			++testCount;
-			paths.pop();
+			++index;
 		}
 		else
 		{
 			++testCount;
+			// The result of a worker is only used once, reruns happen in this thread.
+			if (index < bufferedResults.size() && bufferedResults[index].valid())
+			{
+				pair<Result, string> buffered = bufferedResults[index].get();
+				if (buffered.first == Result::Success || buffered.first == Result::Skipped)
+				{
+					cout << buffered.second;
+					if (buffered.first == Result::Success)
+						++successCount;
+					else
+						++skippedCount;
+					++index;
+					continue;
+				}
+			}
+
 			TestTool testTool(
 				_testCaseCreator,
 				_options,
 				fullpath,
 				currentPath.generic_path().string()
 			);
-			auto result = testTool.process();
+			auto result = testTool.process(cout);
 
 			switch(result)
 			{
@@ -298,7 +368,7 @@ TestStats TestTool::processPath(
 				switch(testTool.handleResponse(result == Result::Exception))
 				{
 				case Request::Quit:
-					paths.pop();
+					++index;
 					m_exitRequested = true;
 					break;
 				case Request::Rerun:
@@ -306,17 +376,17 @@ TestStats TestTool::processPath(
 					--testCount;
 					break;
 				case Request::Skip:
-					paths.pop();
+					++index;
 					++skippedCount;
 					break;
 				}
 				break;
 			case Result::Success:
-				paths.pop();
+				++index;
 				++successCount;
 				break;
 			case Result::Skipped:
-				paths.pop();
+				++index;
 				++skippedCount;
 				break;
 			}
@@ -324,7 +394,6 @@ TestStats TestTool::processPath(
 	}
 
 	return { successCount, testCount, skippedCount };
-
 }
 
 namespace
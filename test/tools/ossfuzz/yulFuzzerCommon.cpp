@@ -31,7 +31,6 @@ void yulFuzzerUtil::interpret(
 	InterpreterState state;
 	state.maxTraceSize = _maxTraceSize;
 	state.maxSteps = _maxSteps;
-	Interpreter interpreter(state, _dialect);
-	interpreter(*_ast);
+	SlotInterpreter(_dialect, *_ast).run(state);
 	state.dumpTraceAndState(_os);
 }
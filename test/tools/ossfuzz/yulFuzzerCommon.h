@@ -15,6 +15,7 @@
 	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include <test/tools/yulInterpreter/Interpreter.h>
+#include <test/tools/yulInterpreter/SlotInterpreter.h>
 #include <libyul/backends/evm/EVMDialect.h>
 
 namespace yul
@@ -47,12 +47,13 @@ void InterpreterState::dumpTraceAndState(ostream& _out) const
 	for (auto const& line: trace)
 		_out << "  " << line << endl;
 	_out << "Memory dump:\n";
-	map<u256, u256> words;
-	for (auto const& [offset, value]: memory)
-		words[(offset / 0x20) * 0x20] |= u256(uint32_t(value)) << (256 - 8 - 8 * size_t(offset % 0x20));
-	for (auto const& [offset, value]: words)
-		if (value != 0)
-			_out << "  " << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << endl;
+	for (auto const& [index, page]: memory.pages())
+		for (size_t offset = 0; offset < PagedMemory::pageSize; offset += 0x20)
+		{
+			h256 value(bytesConstRef(page.data() + offset, 0x20));
+			if (value != h256(0))
+				_out << "  " << std::hex << std::setw(4) << u256(index * PagedMemory::pageSize + offset) << ": " << value.hex() << endl;
+		}
 	_out << "Storage dump:" << endl;
 	for (auto const& slot: storage)
 		if (slot.second != h256(0))
@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <test/tools/yulInterpreter/PagedMemory.h>
+
 #include <libyul/AsmDataForward.h>
 #include <libyul/optimiser/ASTWalker.h>
 
@@ -64,8 +66,8 @@ struct InterpreterState
 {
 	dev::bytes calldata;
 	dev::bytes returndata;
-	std::map<dev::u256, uint8_t> memory;
-	/// This is different than memory.size() because we ignore gas.
+	PagedMemory memory;
+	/// This is different than the size of the allocated pages because we ignore gas.
 	dev::u256 msize;
 	std::map<dev::h256, dev::h256> storage;
 	dev::u160 address = 0x11111111;
@@ -0,0 +1,128 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Memory of the Yul interpreter.
+ */
+
+#include <test/tools/yulInterpreter/PagedMemory.h>
+
+#include <libdevcore/FixedHash.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+using namespace dev;
+using namespace yul::test;
+
+namespace
+{
+
+size_t constexpr pageBits = 12;
+static_assert(PagedMemory::pageSize == size_t(1) << pageBits, "");
+
+u256 pageIndex(u256 const& _offset)
+{
+	return _offset >> pageBits;
+}
+
+size_t pageOffset(u256 const& _offset)
+{
+	return size_t(_offset & (PagedMemory::pageSize - 1));
+}
+
+}
+
+uint8_t PagedMemory::byte(u256 const& _offset) const
+{
+	Page const* page = findPage(pageIndex(_offset));
+	return page ? (*page)[pageOffset(_offset)] : 0;
+}
+
+void PagedMemory::setByte(u256 const& _offset, uint8_t _value)
+{
+	page(pageIndex(_offset))[pageOffset(_offset)] = _value;
+}
+
+u256 PagedMemory::word(u256 const& _offset) const
+{
+	size_t offset = pageOffset(_offset);
+	if (offset + 32 > pageSize)
+		return u256(h256(read(_offset, 32)));
+	Page const* page = findPage(pageIndex(_offset));
+	if (!page)
+		return 0;
+	return u256(h256(bytesConstRef(page->data() + offset, 32)));
+}
+
+void PagedMemory::setWord(u256 const& _offset, u256 const& _value)
+{
+	size_t offset = pageOffset(_offset);
+	if (offset + 32 > pageSize)
+	{
+		writeZeroExtended(_offset, h256(_value).asBytes(), 0, 32);
+		return;
+	}
+	h256 value(_value);
+	memcpy(page(pageIndex(_offset)).data() + offset, value.data(), 32);
+}
+
+bytes PagedMemory::read(u256 const& _offset, size_t _size) const
+{
+	bytes data(_size, 0);
+	u256 offset = _offset;
+	for (size_t position = 0; position < _size;)
+	{
+		size_t chunk = min(_size - position, pageSize - pageOffset(offset));
+		if (Page const* page = findPage(pageIndex(offset)))
+			copy_n(page->begin() + pageOffset(offset), chunk, data.begin() + position);
+		position += chunk;
+		offset += chunk;
+	}
+	return data;
+}
+
+void PagedMemory::writeZeroExtended(u256 const& _offset, bytes const& _source, size_t _sourceOffset, size_t _size)
+{
+	u256 offset = _offset;
+	for (size_t position = 0; position < _size;)
+	{
+		size_t chunk = min(_size - position, pageSize - pageOffset(offset));
+		uint8_t* target = page(pageIndex(offset)).data() + pageOffset(offset);
+		for (size_t i = 0; i < chunk; ++i)
+		{
+			size_t sourcePosition = _sourceOffset + position + i;
+			target[i] = sourcePosition < _source.size() ? _source[sourcePosition] : 0;
+		}
+		position += chunk;
+		offset += chunk;
+	}
+}
+
+PagedMemory::Page const* PagedMemory::findPage(u256 const& _index) const
+{
+	auto it = m_pages.find(_index);
+	return it == m_pages.end() ? nullptr : &it->second;
+}
+
+PagedMemory::Page& PagedMemory::page(u256 const& _index)
+{
+	auto it = m_pages.lower_bound(_index);
+	if (it == m_pages.end() || it->first != _index)
+		it = m_pages.emplace_hint(it, _index, Page{});
+	return it->second;
+}
@@ -0,0 +1,71 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Memory of the Yul interpreter.
+ */
+
+#pragma once
+
+#include <libdevcore/Common.h>
+
+#include <array>
+#include <map>
+
+namespace yul
+{
+namespace test
+{
+
+/**
+ * Sparse, byte-addressed memory that is split into contiguous pages of pageSize bytes.
+ * Pages are only allocated when they are written to, bytes that were never written are zero.
+ * Offsets wrap around at 2**256, like additions of u256 values.
+ */
+class PagedMemory
+{
+public:
+	static size_t constexpr pageSize = 0x1000;
+	using Page = std::array<uint8_t, pageSize>;
+
+	uint8_t byte(dev::u256 const& _offset) const;
+	void setByte(dev::u256 const& _offset, uint8_t _value);
+
+	/// @returns the 32 bytes starting at @a _offset as a big-endian word.
+	dev::u256 word(dev::u256 const& _offset) const;
+	/// Stores @a _value as a big-endian word in the 32 bytes starting at @a _offset.
+	void setWord(dev::u256 const& _offset, dev::u256 const& _value);
+
+	/// @returns the @a _size bytes starting at @a _offset.
+	dev::bytes read(dev::u256 const& _offset, size_t _size) const;
+	/// Copies @a _size bytes of @a _source starting at @a _sourceOffset to @a _offset. Behaves as if
+	/// @a _source would continue with an infinite sequence of zero bytes beyond its end.
+	void writeZeroExtended(dev::u256 const& _offset, dev::bytes const& _source, size_t _sourceOffset, size_t _size);
+
+	/// @returns the pages that were written to, indexed by their offset divided by pageSize.
+	std::map<dev::u256, Page> const& pages() const { return m_pages; }
+
+private:
+	/// @returns the page with index @a _index or nullptr if it was not allocated.
+	Page const* findPage(dev::u256 const& _index) const;
+	/// @returns the page with index @a _index and allocates it if necessary.
+	Page& page(dev::u256 const& _index);
+
+	std::map<dev::u256, Page> m_pages;
+};
+
+}
+}
@@ -0,0 +1,458 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Yul interpreter that executes a lowered form of the code.
+ */
+
+#include <test/tools/yulInterpreter/SlotInterpreter.h>
+
+#include <test/tools/yulInterpreter/EVMInstructionInterpreter.h>
+#include <test/tools/yulInterpreter/Interpreter.h>
+
+#include <libyul/AsmData.h>
+#include <libyul/Dialect.h>
+#include <libyul/Utilities.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/ASTWalker.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <boost/range/adaptor/reversed.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+using namespace yul::test;
+
+/**
+ * Lowers the code outside of functions and, recursively, all functions. Functions are
+ * lowered as soon as the block that defines them is entered, so that they can be called
+ * before their definition.
+ */
+class SlotInterpreter::Lowering: public ASTWalker
+{
+public:
+	Lowering(Dialect const& _dialect, vector<Function>& _functions):
+		m_dialect(dynamic_cast<EVMDialect const*>(&_dialect)),
+		m_functions(_functions)
+	{}
+
+	void lowerMain(Block const& _block)
+	{
+		m_functions.emplace_back();
+		m_function = 0;
+		(*this)(_block);
+	}
+
+	using ASTWalker::operator();
+	void operator()(Literal const& _literal) override
+	{
+		pushConstant(valueOfLiteral(_literal));
+	}
+	void operator()(Identifier const& _identifier) override
+	{
+		emit(OpCode::PushSlot, slot(_identifier.name));
+		m_values = 1;
+	}
+	void operator()(FunctionalInstruction const& _instruction) override
+	{
+		lowerArguments(_instruction.arguments);
+		Operation operation{OpCode::Instruction};
+		operation.instruction = _instruction.instruction;
+		operation.arguments = _instruction.arguments.size();
+		operation.returns = size_t(dev::eth::instructionInfo(_instruction.instruction).ret);
+		function().code.emplace_back(operation);
+		m_values = operation.returns;
+	}
+	void operator()(FunctionCall const& _call) override
+	{
+		lowerArguments(_call.arguments);
+		if (m_dialect)
+			if (BuiltinFunctionForEVM const* builtin = m_dialect->builtin(_call.functionName.name))
+			{
+				Operation operation{OpCode::Builtin};
+				operation.builtin = builtin;
+				operation.arguments = _call.arguments.size();
+				operation.returns = builtin->returns.size();
+				function().code.emplace_back(operation);
+				m_values = operation.returns;
+				return;
+			}
+		size_t callee = calledFunction(_call.functionName.name);
+		solAssert(m_functions[callee].parameters == _call.arguments.size(), "");
+		emit(OpCode::Call, callee);
+		m_values = m_functions[callee].returns;
+	}
+
+	void operator()(ExpressionStatement const& _statement) override
+	{
+		visit(_statement.expression);
+		if (m_values > 0)
+			emit(OpCode::Pop, m_values);
+	}
+	void operator()(Assignment const& _assignment) override
+	{
+		solAssert(_assignment.value, "");
+		visit(*_assignment.value);
+		solAssert(m_values == _assignment.variableNames.size(), "");
+		for (auto const& variable: _assignment.variableNames | boost::adaptors::reversed)
+			emit(OpCode::StoreSlot, slot(variable.name));
+	}
+	void operator()(VariableDeclaration const& _declaration) override
+	{
+		if (_declaration.value)
+		{
+			visit(*_declaration.value);
+			solAssert(m_values == _declaration.variables.size(), "");
+		}
+		else
+			for (size_t i = 0; i < _declaration.variables.size(); ++i)
+				pushConstant(0);
+		vector<size_t> slots;
+		for (auto const& variable: _declaration.variables)
+			slots.emplace_back(declareVariable(variable.name));
+		for (size_t slot: slots | boost::adaptors::reversed)
+			emit(OpCode::StoreSlot, slot);
+	}
+	void operator()(If const& _if) override
+	{
+		solAssert(_if.condition, "");
+		lowerValue(*_if.condition);
+		size_t jump = emit(OpCode::JumpIfZero);
+		(*this)(_if.body);
+		patch(jump);
+	}
+	void operator()(Switch const& _switch) override
+	{
+		solAssert(_switch.expression, "");
+		solAssert(!_switch.cases.empty(), "");
+		lowerValue(*_switch.expression);
+		size_t value = function().slots++;
+		emit(OpCode::StoreSlot, value);
+		vector<size_t> jumpsToEnd;
+		for (auto const& switchCase: _switch.cases)
+		{
+			size_t jumpToNextCase = size_t(-1);
+			if (switchCase.value)
+			{
+				(*this)(*switchCase.value);
+				emit(OpCode::PushSlot, value);
+				jumpToNextCase = emit(OpCode::JumpIfNotEqual);
+			}
+			(*this)(switchCase.body);
+			jumpsToEnd.emplace_back(emit(OpCode::Jump));
+			if (jumpToNextCase != size_t(-1))
+				patch(jumpToNextCase);
+		}
+		for (size_t jump: jumpsToEnd)
+			patch(jump);
+	}
+	void operator()(FunctionDefinition const&) override
+	{
+		// Functions are lowered when their block is entered.
+	}
+	void operator()(ForLoop const& _loop) override
+	{
+		solAssert(_loop.condition, "");
+		// The pre block is not executed as a block, it only opens the scope of the loop.
+		openScope(_loop.pre);
+		for (auto const& statement: _loop.pre.statements)
+			visit(statement);
+
+		size_t condition = function().code.size();
+		lowerValue(*_loop.condition);
+		size_t exit = emit(OpCode::JumpIfZero);
+		m_loops.emplace_back();
+		(*this)(_loop.body);
+		for (size_t jump: m_loops.back().continues)
+			patch(jump);
+		(*this)(_loop.post);
+		emit(OpCode::Jump, condition);
+		patch(exit);
+		for (size_t jump: m_loops.back().breaks)
+			patch(jump);
+		m_loops.pop_back();
+		closeScope();
+	}
+	void operator()(Break const&) override
+	{
+		solAssert(!m_loops.empty(), "");
+		m_loops.back().breaks.emplace_back(emit(OpCode::Jump));
+	}
+	void operator()(Continue const&) override
+	{
+		solAssert(!m_loops.empty(), "");
+		m_loops.back().continues.emplace_back(emit(OpCode::Jump));
+	}
+	void operator()(Block const& _block) override
+	{
+		emit(OpCode::Step);
+		openScope(_block);
+		for (auto const& statement: _block.statements)
+			visit(statement);
+		closeScope();
+	}
+
+private:
+	struct Loop
+	{
+		vector<size_t> breaks;
+		vector<size_t> continues;
+	};
+
+	Function& function() { return m_functions[m_function]; }
+
+	/// Appends an operation and @returns its position.
+	size_t emit(OpCode _code, size_t _argument = 0)
+	{
+		Operation operation{_code};
+		operation.argument = _argument;
+		function().code.emplace_back(operation);
+		return function().code.size() - 1;
+	}
+	/// Sets the target of the jump at @a _position to the next operation.
+	void patch(size_t _position)
+	{
+		function().code[_position].argument = function().code.size();
+	}
+
+	void pushConstant(u256 _value)
+	{
+		emit(OpCode::PushConstant, function().constants.size());
+		function().constants.emplace_back(move(_value));
+		m_values = 1;
+	}
+	void lowerValue(Expression const& _expression)
+	{
+		visit(_expression);
+		solAssert(m_values == 1, "");
+	}
+	/// Arguments are evaluated from right to left, so the first argument is on top of the stack.
+	void lowerArguments(vector<Expression> const& _arguments)
+	{
+		for (auto const& argument: _arguments | boost::adaptors::reversed)
+			lowerValue(argument);
+	}
+
+	/// Opens a scope and lowers the functions defined in @a _block.
+	void openScope(Block const& _block)
+	{
+		m_variables.emplace_back();
+		m_functionScopes.emplace_back();
+		vector<FunctionDefinition const*> definitions;
+		for (auto const& statement: _block.statements)
+			if (FunctionDefinition const* definition = boost::get<FunctionDefinition>(&statement))
+			{
+				solAssert(!m_functionScopes.back().count(definition->name), "");
+				m_functionScopes.back()[definition->name] = m_functions.size();
+				m_functions.emplace_back();
+				m_functions.back().parameters = definition->parameters.size();
+				m_functions.back().returns = definition->returnVariables.size();
+				definitions.emplace_back(definition);
+			}
+		for (FunctionDefinition const* definition: definitions)
+			lowerFunction(*definition);
+	}
+	void closeScope()
+	{
+		m_variables.pop_back();
+		m_functionScopes.pop_back();
+	}
+
+	void lowerFunction(FunctionDefinition const& _function)
+	{
+		// Functions only see the functions of the enclosing scopes, not their variables or loops.
+		size_t outerFunction = m_function;
+		vector<map<YulString, size_t>> outerVariables = move(m_variables);
+		vector<Loop> outerLoops = move(m_loops);
+		m_function = m_functionScopes.back().at(_function.name);
+		m_variables = {{}};
+		m_loops = {};
+
+		for (auto const& parameter: _function.parameters)
+			declareVariable(parameter.name);
+		for (auto const& returnVariable: _function.returnVariables)
+			declareVariable(returnVariable.name);
+		(*this)(_function.body);
+
+		m_function = outerFunction;
+		m_variables = move(outerVariables);
+		m_loops = move(outerLoops);
+	}
+
+	size_t declareVariable(YulString _name)
+	{
+		solAssert(!m_variables.back().count(_name), "");
+		return m_variables.back()[_name] = function().slots++;
+	}
+	size_t slot(YulString _name) const
+	{
+		for (auto const& scope: m_variables | boost::adaptors::reversed)
+			if (scope.count(_name))
+				return scope.at(_name);
+		solAssert(false, "Variable not found.");
+		return 0;
+	}
+	size_t calledFunction(YulString _name) const
+	{
+		for (auto const& scope: m_functionScopes | boost::adaptors::reversed)
+			if (scope.count(_name))
+				return scope.at(_name);
+		solAssert(false, "Function not found.");
+		return 0;
+	}
+
+	EVMDialect const* m_dialect;
+	vector<Function>& m_functions;
+	size_t m_function = 0;
+	/// Number of values the last lowered expression pushes to the stack.
+	size_t m_values = 0;
+	/// Slots of the variables in scope, for the current function only.
+	vector<map<YulString, size_t>> m_variables;
+	/// Indices of the functions in scope.
+	vector<map<YulString, size_t>> m_functionScopes;
+	vector<Loop> m_loops;
+};
+
+/**
+ * State of a single run of the lowered code. The frames of all active functions are stored
+ * in one vector of slots and the values of all active expressions in one value stack.
+ */
+class SlotInterpreter::Execution
+{
+public:
+	Execution(vector<Function> const& _functions, InterpreterState& _state):
+		m_functions(_functions),
+		m_state(_state),
+		m_evm(_state)
+	{}
+
+	void run()
+	{
+		m_slots.resize(m_functions.front().slots);
+		execute(m_functions.front(), 0);
+	}
+
+private:
+	void execute(Function const& _function, size_t _frame)
+	{
+		vector<Operation> const& code = _function.code;
+		for (size_t position = 0; position < code.size();)
+		{
+			Operation const& operation = code[position++];
+			switch (operation.code)
+			{
+			case OpCode::Step:
+				m_state.numSteps++;
+				if (m_state.maxSteps > 0 && m_state.numSteps >= m_state.maxSteps)
+				{
+					m_state.trace.emplace_back("Interpreter execution step limit reached.");
+					throw StepLimitReached();
+				}
+				break;
+			case OpCode::PushConstant:
+				m_stack.emplace_back(_function.constants[operation.argument]);
+				break;
+			case OpCode::PushSlot:
+				m_stack.emplace_back(m_slots[_frame + operation.argument]);
+				break;
+			case OpCode::StoreSlot:
+				m_slots[_frame + operation.argument] = move(m_stack.back());
+				m_stack.pop_back();
+				break;
+			case OpCode::Pop:
+				m_stack.resize(m_stack.size() - operation.argument);
+				break;
+			case OpCode::Jump:
+				position = operation.argument;
+				break;
+			case OpCode::JumpIfZero:
+			{
+				bool zero = m_stack.back() == 0;
+				m_stack.pop_back();
+				if (zero)
+					position = operation.argument;
+				break;
+			}
+			case OpCode::JumpIfNotEqual:
+			{
+				bool equal = m_stack[m_stack.size() - 1] == m_stack[m_stack.size() - 2];
+				m_stack.resize(m_stack.size() - 2);
+				if (!equal)
+					position = operation.argument;
+				break;
+			}
+			case OpCode::Instruction:
+				popArguments(operation.arguments);
+				pushReturnValue(operation.returns, m_evm.eval(operation.instruction, m_arguments));
+				break;
+			case OpCode::Builtin:
+				popArguments(operation.arguments);
+				pushReturnValue(operation.returns, m_evm.evalBuiltin(*operation.builtin, m_arguments));
+				break;
+			case OpCode::Call:
+			{
+				Function const& callee = m_functions[operation.argument];
+				size_t frame = m_slots.size();
+				m_slots.resize(frame + callee.slots);
+				for (size_t i = 0; i < callee.parameters; ++i)
+					m_slots[frame + i] = m_stack[m_stack.size() - 1 - i];
+				m_stack.resize(m_stack.size() - callee.parameters);
+				execute(callee, frame);
+				for (size_t i = 0; i < callee.returns; ++i)
+					m_stack.emplace_back(m_slots[frame + callee.parameters + i]);
+				m_slots.resize(frame);
+				break;
+			}
+			}
+		}
+	}
+
+	/// Moves the top @a _count values of the stack to m_arguments, the top value first.
+	void popArguments(size_t _count)
+	{
+		m_arguments.resize(_count);
+		for (size_t i = 0; i < _count; ++i)
+			m_arguments[i] = m_stack[m_stack.size() - 1 - i];
+		m_stack.resize(m_stack.size() - _count);
+	}
+	void pushReturnValue(size_t _returns, u256 _value)
+	{
+		solAssert(_returns <= 1, "");
+		if (_returns == 1)
+			m_stack.emplace_back(move(_value));
+	}
+
+	vector<Function> const& m_functions;
+	InterpreterState& m_state;
+	EVMInstructionInterpreter m_evm;
+	vector<u256> m_slots;
+	vector<u256> m_stack;
+	vector<u256> m_arguments;
+};
+
+SlotInterpreter::SlotInterpreter(Dialect const& _dialect, Block const& _ast)
+{
+	Lowering(_dialect, m_functions).lowerMain(_ast);
+}
+
+void SlotInterpreter::run(InterpreterState& _state) const
+{
+	Execution(m_functions, _state).run();
+}
@@ -0,0 +1,125 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Yul interpreter that executes a lowered form of the code.
+ */
+
+#pragma once
+
+#include <libyul/AsmDataForward.h>
+#include <libyul/YulString.h>
+
+#include <libdevcore/Common.h>
+
+#include <map>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+enum class Instruction: uint8_t;
+}
+}
+
+namespace yul
+{
+struct Dialect;
+struct BuiltinFunctionForEVM;
+
+namespace test
+{
+
+struct InterpreterState;
+
+/**
+ * Yul interpreter that lowers the code to a list of operations per function before it is run.
+ * Variables are resolved to slots of the frame of their function, function calls to
+ * indices of functions and calls to builtins to the builtins themselves, so that no names
+ * are looked up at runtime. Expressions are evaluated on a value stack and control flow
+ * is lowered to jumps.
+ *
+ * Executing the code has the same effect on the InterpreterState as the Interpreter,
+ * including the trace, the step counter and the exceptions that terminate the execution.
+ * The program can be run any number of times.
+ */
+class SlotInterpreter
+{
+public:
+	SlotInterpreter(Dialect const& _dialect, Block const& _ast);
+
+	/// Executes the code on @a _state. Throws InterpreterTerminatedGeneric like the Interpreter.
+	void run(InterpreterState& _state) const;
+
+private:
+	enum class OpCode: uint8_t
+	{
+		/// Counts the execution of a block towards the step limit.
+		Step,
+		/// Pushes constants[argument].
+		PushConstant,
+		/// Pushes the value of the slot @a argument.
+		PushSlot,
+		/// Pops a value and stores it in the slot @a argument.
+		StoreSlot,
+		/// Discards @a argument values.
+		Pop,
+		/// Continues at @a argument.
+		Jump,
+		/// Pops a value and continues at @a argument if it is zero.
+		JumpIfZero,
+		/// Pops two values and continues at @a argument if they are not equal.
+		JumpIfNotEqual,
+		/// Pops the arguments of @a instruction and pushes its return value, if any.
+		Instruction,
+		/// Pops the arguments of @a builtin and pushes its return value, if any.
+		Builtin,
+		/// Pops the arguments of the function @a argument and pushes its return values.
+		Call
+	};
+
+	struct Operation
+	{
+		OpCode code;
+		/// Constant, slot, jump target, number of values or function, depending on the code.
+		size_t argument = 0;
+		/// Number of arguments and return values of instructions and builtins.
+		size_t arguments = 0;
+		size_t returns = 0;
+		dev::eth::Instruction instruction{};
+		BuiltinFunctionForEVM const* builtin = nullptr;
+	};
+
+	struct Function
+	{
+		size_t parameters = 0;
+		size_t returns = 0;
+		/// Number of slots of a frame: parameters, return variables and local variables.
+		size_t slots = 0;
+		std::vector<Operation> code;
+		std::vector<dev::u256> constants;
+	};
+
+	class Lowering;
+	class Execution;
+
+	/// Lowered functions, the code outside of functions is the first one.
+	std::vector<Function> m_functions;
+};
+
+}
+}
@@ -15,7 +15,7 @@
 	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
 */
 /**
- * Interactive yul optimizer
+ * Interactive yul optimizer and optimizer benchmark
  */
 
 #include <libdevcore/CommonIO.h>
@@ -59,13 +59,16 @@
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/LoadResolver.h>
+#include <libyul/optimiser/Suite.h>
 
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 
 #include <libdevcore/JSON.h>
 
 #include <boost/program_options.hpp>
 
+#include <chrono>
 #include <string>
 #include <sstream>
 #include <iostream>
@@ -227,6 +230,16 @@ public:
 		}
 	}
 
+	/// Applies the full optimiser suite to the parsed code.
+	void runFullSuite()
+	{
+		GasMeter meter(dynamic_cast<EVMDialect const&>(m_dialect), false, 200);
+		Object obj;
+		obj.code = m_ast;
+		obj.analysisInfo = m_analysisInfo;
+		OptimiserSuite::run(m_dialect, &meter, obj, true);
+	}
+
 private:
 	ErrorList m_errors;
 	shared_ptr<yul::Block> m_ast;
@@ -235,6 +248,35 @@ private:
 	shared_ptr<NameDispenser> m_nameDispenser;
 };
 
+/// Parses all @a _files, applies the full optimiser suite to them and reports the time spent
+/// in the parser and in the optimiser. Files that cannot be parsed are skipped.
+void benchmark(vector<string> const& _files)
+{
+	chrono::steady_clock::duration parsing{};
+	chrono::steady_clock::duration optimising{};
+	size_t optimised = 0;
+	for (string const& file: _files)
+	{
+		string source = readFileAsString(file);
+		YulOpti opti;
+		auto start = chrono::steady_clock::now();
+		if (!opti.parse(source))
+		{
+			cout << "Skipping " << file << endl;
+			continue;
+		}
+		auto parsed = chrono::steady_clock::now();
+		opti.runFullSuite();
+		optimising += chrono::steady_clock::now() - parsed;
+		parsing += parsed - start;
+		optimised++;
+	}
+	cout <<
+		"Processed " << optimised << " of " << _files.size() << " files." << endl <<
+		"Parsing: " << chrono::duration_cast<chrono::milliseconds>(parsing).count() << " ms" << endl <<
+		"Optimiser: " << chrono::duration_cast<chrono::milliseconds>(optimising).count() << " ms" << endl;
+}
+
 int main(int argc, char** argv)
 {
 	po::options_description options(
@@ -243,20 +285,25 @@ Usage: yulopti [Options] <file>
 Reads <file> as yul code and applies optimizer steps to it,
 interactively read from stdin.
 
+Usage: yulopti --benchmark <file>...
+Parses all files, applies the full optimizer suite to them and reports
+the time spent in the parser and in the optimizer.
+
 Allowed options)",
 		po::options_description::m_default_line_length,
 		po::options_description::m_default_line_length - 23);
 	options.add_options()
 		(
 			"input-file",
-			po::value<string>(),
+			po::value<vector<string>>(),
 			"input file"
 		)
+		("benchmark", "Apply the full optimizer suite to all input files non-interactively.")
 		("help", "Show this help screen.");
 
 	// All positional options should be interpreted as input files
 	po::positional_options_description filesPositions;
-	filesPositions.add("input-file", 1);
+	filesPositions.add("input-file", -1);
 
 	po::variables_map arguments;
 	try
@@ -271,11 +318,17 @@ Allowed options)",
 		return 1;
 	}
 
-	string input;
-	if (arguments.count("input-file"))
-		YulOpti{}.runInteractive(readFileAsString(arguments["input-file"].as<string>()));
-	else
+	if (!arguments.count("input-file"))
 		cout << options;
+	else if (arguments.count("benchmark"))
+		benchmark(arguments["input-file"].as<vector<string>>());
+	else if (arguments["input-file"].as<vector<string>>().size() == 1)
+		YulOpti{}.runInteractive(readFileAsString(arguments["input-file"].as<vector<string>>().front()));
+	else
+	{
+		cerr << "Only a single input file is supported in interactive mode." << endl;
+		return 1;
+	}
 
 	return 0;
 }